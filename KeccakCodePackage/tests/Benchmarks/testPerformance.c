@@ -47,6 +47,41 @@ void displayMeasurements1101001000(cycles_t *measurements, uint32_t *laneCounts,
 #define xstr(s) str(s)
 #define str(s) #s
 
+/* The hash calls made by the Kyber KEM, see the Kyber specification:
+ * matrix expansion (SHAKE128 of seed||i||j, 3 blocks almost always, 4 or 5
+ * when rejection sampling runs short), noise sampling (SHAKE256 of
+ * seed||nonce, 128 bytes for eta=2 and 192 for eta=3), H on the message,
+ * on the ciphertexts and public keys of Kyber512/768/1024, and G. */
+typedef struct {
+    const char *name;
+    unsigned int rateInBytes;
+    unsigned char delimitedSuffix;
+    unsigned int inputByteLen;
+    unsigned int outputByteLen;
+} KyberCallShape;
+
+static const KyberCallShape kyberCallShapes[] = {
+    { "SHAKE128, 34 bytes -> 3 blocks",          168, 0x1F,   34, 3*168 },
+    { "SHAKE128, 34 bytes -> 4 blocks",          168, 0x1F,   34, 4*168 },
+    { "SHAKE128, 34 bytes -> 5 blocks",          168, 0x1F,   34, 5*168 },
+    { "SHAKE256, 33 bytes -> 128 bytes",         136, 0x1F,   33,   128 },
+    { "SHAKE256, 33 bytes -> 192 bytes",         136, 0x1F,   33,   192 },
+    { "SHA3-256, 32 bytes",                      136, 0x06,   32,    32 },
+    { "SHA3-256, 768 bytes (Kyber512 ct)",       136, 0x06,  768,    32 },
+    { "SHA3-256, 800 bytes (Kyber512 pk)",       136, 0x06,  800,    32 },
+    { "SHA3-256, 1088 bytes (Kyber768 ct)",      136, 0x06, 1088,    32 },
+    { "SHA3-256, 1184 bytes (Kyber768 pk)",      136, 0x06, 1184,    32 },
+    { "SHA3-256, 1568 bytes (Kyber1024 pk/ct)",  136, 0x06, 1568,    32 },
+    { "SHA3-512, 64 bytes",                       72, 0x06,   64,    64 },
+};
+static const unsigned int kyberCallShapeCount = sizeof(kyberCallShapes)/sizeof(kyberCallShapes[0]);
+
+static unsigned int KyberCallShape_permutations(const KyberCallShape *shape)
+{
+    return shape->inputByteLen/shape->rateInBytes
+        + (shape->outputByteLen + shape->rateInBytes - 1)/shape->rateInBytes;
+}
+
 #ifdef XKCP_has_KeccakP1600
     #include "KeccakP-1600-SnP.h"
 
@@ -58,6 +93,7 @@ void displayMeasurements1101001000(cycles_t *measurements, uint32_t *laneCounts,
     #define SnP_Permute_12rounds KeccakP1600_Permute_12rounds
     #define SnP_FastLoop_Absorb KeccakF1600_FastLoop_Absorb
         #include "timingSnP.inc"
+        #include "timingKyberSnP.inc"
     #undef prefix
     #undef SnP
     #undef SnP_state
@@ -124,6 +160,7 @@ unsigned int KeccakP1600_gatherSnP_GenericLoop_Absorb(cycles_t dtMin, cycles_t *
     #define PlSnP_FastLoop_Absorb KeccakF1600times2_FastLoop_Absorb
     #define PlSnP_GetFeatures           KeccakP1600times2_GetFeatures
         #include "timingPlSnP.inc"
+        #include "timingKyberPlSnP.inc"
     #undef prefix
     #undef PlSnP
     #undef PlSnP_parallelism
@@ -146,6 +183,7 @@ unsigned int KeccakP1600_gatherSnP_GenericLoop_Absorb(cycles_t dtMin, cycles_t *
     #define PlSnP_FastLoop_Absorb KeccakF1600times4_FastLoop_Absorb
     #define PlSnP_GetFeatures           KeccakP1600times4_GetFeatures
         #include "timingPlSnP.inc"
+        #include "timingKyberPlSnP.inc"
     #undef prefix
     #undef PlSnP
     #undef PlSnP_parallelism
@@ -168,6 +206,7 @@ unsigned int KeccakP1600_gatherSnP_GenericLoop_Absorb(cycles_t dtMin, cycles_t *
     #define PlSnP_FastLoop_Absorb KeccakF1600times8_FastLoop_Absorb
     #define PlSnP_GetFeatures           KeccakP1600times8_GetFeatures
         #include "timingPlSnP.inc"
+        #include "timingKyberPlSnP.inc"
     #undef prefix
     #undef PlSnP
     #undef PlSnP_parallelism
@@ -1082,18 +1121,25 @@ void testPerformance()
 {
 #ifdef XKCP_has_KeccakP1600
     KeccakP1600_timingSnP("Keccak-p[1600]", KeccakP1600_GetImplementation());
+    KeccakP1600_timingKyberSnP("Keccak-p[1600]", KeccakP1600_GetImplementation());
 #endif
 #ifdef XKCP_has_KeccakP1600times2
-    if (KeccakP1600times2_GetFeatures())
+    if (KeccakP1600times2_GetFeatures()) {
         KeccakP1600times2_timingPlSnP("Keccak-p[1600]\303\2272", KeccakP1600times2_GetImplementation());
+        KeccakP1600times2_timingKyberPlSnP("Keccak-p[1600]\303\2272", KeccakP1600times2_GetImplementation());
+    }
 #endif
 #ifdef XKCP_has_KeccakP1600times4
-    if (KeccakP1600times4_GetFeatures())
+    if (KeccakP1600times4_GetFeatures()) {
         KeccakP1600times4_timingPlSnP("Keccak-p[1600]\303\2274", KeccakP1600times4_GetImplementation());
+        KeccakP1600times4_timingKyberPlSnP("Keccak-p[1600]\303\2274", KeccakP1600times4_GetImplementation());
+    }
 #endif
 #ifdef XKCP_has_KeccakP1600times8
-    if (KeccakP1600times8_GetFeatures())
+    if (KeccakP1600times8_GetFeatures()) {
         KeccakP1600times8_timingPlSnP("Keccak-p[1600]\303\2278", KeccakP1600times8_GetImplementation());
+        KeccakP1600times8_timingKyberPlSnP("Keccak-p[1600]\303\2278", KeccakP1600times8_GetImplementation());
+    }
 #endif
 
 #ifdef XKCP_has_Sponge_Keccak_width1600
@@ -1,5 +1,6 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "params.h"
 #include "indcpa.h"
 #include "poly.h"
@@ -474,6 +475,77 @@ void gen_matrix(polyvec *a, const uint8_t seed[32], int transposed)
   }
 }
 #endif
+
+/*************************************************
+* Name:        gen_at_batch
+*
+* Description: Generate the transposed matrices A^T of up to
+*              INDCPA_BATCH_MAX seeds. The n*KYBER_K*KYBER_K entries
+*              are sampled in groups of four with the 4-way SHAKE128,
+*              regardless of which seed they belong to; a single
+*              leftover entry is sampled with the 1-way SHAKE128.
+*
+* Arguments:   - polyvec (*at)[KYBER_K]: pointer to output matrices
+*              - const uint8_t **seed:   array of pointers to input seeds
+*              - unsigned int n:         number of seeds
+**************************************************/
+static void gen_at_batch(polyvec at[][KYBER_K],
+                         const uint8_t *seed[],
+                         unsigned int n)
+{
+  unsigned int b, i, j, e, l, m, idx, ctr[4];
+  const unsigned int total = n*KYBER_K*KYBER_K;
+  __attribute__((aligned(32)))
+  uint8_t buf[4][(GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES+31)/32*32];
+  poly pad, *r[4];
+  keccakx4_state state;
+  keccak_state state1x;
+
+  for(e=0;e<total;e+=4) {
+    m = (total - e < 4) ? total - e : 4;
+
+    /* unused lanes repeat the first entry into a scratch polynomial */
+    for(l=0;l<4;l++) {
+      idx = e + ((l < m) ? l : 0);
+      b = idx/(KYBER_K*KYBER_K);
+      i = (idx/KYBER_K) % KYBER_K;
+      j = idx % KYBER_K;
+      memcpy(buf[l], seed[b], KYBER_SYMBYTES);
+      buf[l][KYBER_SYMBYTES+0] = i;
+      buf[l][KYBER_SYMBYTES+1] = j;
+      r[l] = (l < m) ? &at[b][i].vec[j] : &pad;
+    }
+
+    if(m == 1) {
+      shake128_absorb(&state1x, buf[0], KYBER_SYMBYTES+2);
+      shake128_squeezeblocks(buf[0], GEN_MATRIX_NBLOCKS, &state1x);
+      ctr[0] = rej_uniform_avx(r[0]->coeffs, buf[0]);
+      while(ctr[0] < KYBER_N) {
+        shake128_squeezeblocks(buf[0], 1, &state1x);
+        ctr[0] += rej_uniform(r[0]->coeffs + ctr[0], KYBER_N - ctr[0], buf[0],
+                              XOF_BLOCKBYTES);
+      }
+      poly_nttunpack(r[0]);
+      continue;
+    }
+
+    shake128x4_absorb(&state, buf[0], buf[1], buf[2], buf[3], KYBER_SYMBYTES+2);
+    shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], GEN_MATRIX_NBLOCKS,
+                             &state);
+    for(l=0;l<4;l++)
+      ctr[l] = rej_uniform_avx(r[l]->coeffs, buf[l]);
+
+    while(ctr[0] < KYBER_N || ctr[1] < KYBER_N || ctr[2] < KYBER_N || ctr[3] < KYBER_N) {
+      shake128x4_squeezeblocks(buf[0], buf[1], buf[2], buf[3], 1, &state);
+      for(l=0;l<4;l++)
+        ctr[l] += rej_uniform(r[l]->coeffs + ctr[l], KYBER_N - ctr[l], buf[l],
+                              XOF_BLOCKBYTES);
+    }
+
+    for(l=0;l<m;l++)
+      poly_nttunpack(r[l]);
+  }
+}
 #endif
 
 /*************************************************
@@ -565,10 +637,10 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 }
 
 /*************************************************
-* Name:        indcpa_enc
+* Name:        enc_at
 *
-* Description: Encryption function of the CPA-secure
-*              public-key encryption scheme underlying Kyber.
+* Description: Encryption with the transposed matrix A^T already
+*              expanded from the seed in the public key
 *
 * Arguments:   - uint8_t *c:           pointer to output ciphertext
 *                                      (of length KYBER_INDCPA_BYTES bytes)
@@ -577,24 +649,23 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
 *              - const uint8_t *pk:    pointer to input public key
 *                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
 *              - const uint8_t *coins: pointer to input random coins
-*                                      used as seed (of length KYBER_SYMBYTES)
-*                                      to deterministically generate all
-*                                      randomness
+*                                      (of length KYBER_SYMBYTES)
+*              - const polyvec *at:    pointer to input matrix A^T
 **************************************************/
-void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
-                const uint8_t m[KYBER_INDCPA_MSGBYTES],
-                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
-                const uint8_t coins[KYBER_SYMBYTES])
+static void enc_at(uint8_t c[KYBER_INDCPA_BYTES],
+                   const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                   const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                   const uint8_t coins[KYBER_SYMBYTES],
+                   const polyvec at[KYBER_K])
 {
   unsigned int i;
   __attribute__((aligned(32)))
   uint8_t seed[KYBER_SYMBYTES];
-  polyvec sp, pkpv, ep, at[KYBER_K], bp;
+  polyvec sp, pkpv, ep, bp;
   poly v, k, epp;
 
   unpack_pk(&pkpv, seed, pk);
   poly_frommsg(&k, m);
-  gen_at(at, seed);
 
 #ifdef KYBER_90S
 #define NBLOCKS ((2*KYBER_ETA1*32)/AES256CTR_BLOCKBYTES ) /* Assumes divisibility */
@@ -665,6 +736,76 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   pack_ciphertext(c, &bp, &v);
 }
 
+/*************************************************
+* Name:        indcpa_enc
+*
+* Description: Encryption function of the CPA-secure
+*              public-key encryption scheme underlying Kyber.
+*
+* Arguments:   - uint8_t *c:           pointer to output ciphertext
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      used as seed (of length KYBER_SYMBYTES)
+*                                      to deterministically generate all
+*                                      randomness
+**************************************************/
+void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
+                const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                const uint8_t coins[KYBER_SYMBYTES])
+{
+  unsigned int i;
+  __attribute__((aligned(32)))
+  uint8_t seed[KYBER_SYMBYTES];
+  polyvec at[KYBER_K];
+
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    seed[i] = pk[i+KYBER_POLYVECBYTES];
+  gen_at(at, seed);
+  enc_at(c, m, pk, coins, at);
+}
+
+/*************************************************
+* Name:        indcpa_enc_batch
+*
+* Description: Up to INDCPA_BATCH_MAX independent encryptions. The
+*              matrices of all public keys are expanded together so
+*              that every call of the 4-way SHAKE128 fills all lanes;
+*              the outputs are identical to those of indcpa_enc.
+*
+* Arguments:   - uint8_t **c:           array of pointers to output ciphertexts
+*              - const uint8_t **m:     array of pointers to input messages
+*              - const uint8_t **pk:    array of pointers to input public keys
+*              - const uint8_t **coins: array of pointers to input coins
+*              - unsigned int n:        number of encryptions
+*                                       (at most INDCPA_BATCH_MAX)
+**************************************************/
+void indcpa_enc_batch(uint8_t *c[],
+                      const uint8_t *m[],
+                      const uint8_t *pk[],
+                      const uint8_t *coins[],
+                      unsigned int n)
+{
+  unsigned int i;
+#ifdef KYBER_90S
+  for(i=0;i<n;i++)
+    indcpa_enc(c[i], m[i], pk[i], coins[i]);
+#else
+  const uint8_t *seed[INDCPA_BATCH_MAX];
+  polyvec at[INDCPA_BATCH_MAX][KYBER_K];
+
+  for(i=0;i<n;i++)
+    seed[i] = pk[i]+KYBER_POLYVECBYTES;
+  gen_at_batch(at, seed, n);
+  for(i=0;i<n;i++)
+    enc_at(c[i], m[i], pk[i], coins[i], at[i]);
+#endif
+}
+
 /*************************************************
 * Name:        indcpa_dec
 *
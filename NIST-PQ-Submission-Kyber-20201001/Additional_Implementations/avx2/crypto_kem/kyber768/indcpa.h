@@ -17,6 +17,15 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                 const uint8_t coins[KYBER_SYMBYTES]);
 
+#define INDCPA_BATCH_MAX 4
+
+#define indcpa_enc_batch KYBER_NAMESPACE(_indcpa_enc_batch)
+void indcpa_enc_batch(uint8_t *c[],
+                      const uint8_t *m[],
+                      const uint8_t *pk[],
+                      const uint8_t *coins[],
+                      unsigned int n);
+
 #define indcpa_dec KYBER_NAMESPACE(_indcpa_dec)
 void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t c[KYBER_INDCPA_BYTES],
@@ -1,5 +1,6 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "kem.h"
 #include "params.h"
 #include "rng.h"
@@ -128,3 +129,179 @@ int crypto_kem_dec(unsigned char *ss,
   kdf(ss, kr, 2*KYBER_SYMBYTES);
   return 0;
 }
+
+#define BATCH_H   0
+#define BATCH_G   1
+#define BATCH_KDF 2
+
+/*************************************************
+* Name:        hash_batch
+*
+* Description: Apply hash_h, hash_g or kdf to n inputs of equal length,
+*              four at a time with the 4-way Keccak. Unused lanes of the
+*              last group repeat the first input into a scratch buffer,
+*              a single leftover input is hashed with the 1-way code.
+*
+* Arguments:   - uint8_t **out:      array of pointers to outputs
+*              - const uint8_t **in: array of pointers to inputs
+*              - size_t inlen:       length of each input in bytes
+*              - unsigned int n:     number of inputs
+*              - int f:              BATCH_H, BATCH_G or BATCH_KDF
+**************************************************/
+static void hash_batch(uint8_t *out[],
+                       const uint8_t *in[],
+                       size_t inlen,
+                       unsigned int n,
+                       int f)
+{
+  unsigned int i, j;
+#ifndef KYBER_90S
+  uint8_t pad[2*KYBER_SYMBYTES];
+  uint8_t *o[4];
+  const uint8_t *x[4];
+#endif
+
+  for(i=0;i<n;i+=4) {
+#ifndef KYBER_90S
+    if(n - i > 1) {
+      for(j=0;j<4;j++) {
+        o[j] = (i+j < n) ? out[i+j] : pad;
+        x[j] = (i+j < n) ? in[i+j] : in[i];
+      }
+      if(f == BATCH_H)
+        sha3_256x4(o[0], o[1], o[2], o[3], x[0], x[1], x[2], x[3], inlen);
+      else if(f == BATCH_G)
+        sha3_512x4(o[0], o[1], o[2], o[3], x[0], x[1], x[2], x[3], inlen);
+      else
+        shake256x4(o[0], o[1], o[2], o[3], KYBER_SSBYTES,
+                   x[0], x[1], x[2], x[3], inlen);
+      continue;
+    }
+#endif
+    for(j=i;j<n && j<i+4;j++) {
+      if(f == BATCH_H)
+        hash_h(out[j], in[j], inlen);
+      else if(f == BATCH_G)
+        hash_g(out[j], in[j], inlen);
+      else
+        kdf(out[j], in[j], inlen);
+    }
+  }
+}
+
+/*************************************************
+* Name:        crypto_kem_batch
+*
+* Description: Runs nenc encapsulations and ndec decapsulations as one
+*              batch. The hashes of all operations are computed together
+*              with the 4-way Keccak and the matrices of all (re-)
+*              encryptions are expanded together, see indcpa_enc_batch.
+*              Outputs are identical to nenc calls of crypto_kem_enc
+*              followed by ndec calls of crypto_kem_dec; randombytes is
+*              called in the same order.
+*
+* Arguments:   - unsigned char **ct:           array of pointers to output
+*                                              cipher texts of the encapsulations
+*              - unsigned char **ss_enc:       array of pointers to output
+*                                              shared secrets of the encapsulations
+*              - const unsigned char **pk:     array of pointers to input
+*                                              public keys
+*              - unsigned int nenc:            number of encapsulations
+*              - unsigned char **ss_dec:       array of pointers to output
+*                                              shared secrets of the decapsulations
+*              - const unsigned char **ct_dec: array of pointers to input
+*                                              cipher texts
+*              - const unsigned char **sk:     array of pointers to input
+*                                              private keys
+*              - unsigned int ndec:            number of decapsulations
+*
+* Returns 0, or -1 if nenc + ndec exceeds KEM_BATCH_MAX.
+*
+* On failure of a decapsulation, its ss_dec will contain a pseudo-random
+* value.
+**************************************************/
+#if KEM_BATCH_MAX > INDCPA_BATCH_MAX
+#error "crypto_kem_batch passes up to KEM_BATCH_MAX encryptions to indcpa_enc_batch"
+#endif
+
+int crypto_kem_batch(unsigned char *ct[],
+                     unsigned char *ss_enc[],
+                     const unsigned char *pk[],
+                     unsigned int nenc,
+                     unsigned char *ss_dec[],
+                     const unsigned char *ct_dec[],
+                     const unsigned char *sk[],
+                     unsigned int ndec)
+{
+  unsigned int i, d;
+  const unsigned int n = nenc + ndec;
+  int fail;
+  __attribute__((aligned(32)))
+  uint8_t buf[KEM_BATCH_MAX][2*KYBER_SYMBYTES];
+  /* Will contain key, coins */
+  __attribute__((aligned(32)))
+  uint8_t kr[KEM_BATCH_MAX][2*KYBER_SYMBYTES];
+  uint8_t cmp[KEM_BATCH_MAX][KYBER_CIPHERTEXTBYTES];
+  uint8_t *out[KEM_BATCH_MAX], *c[KEM_BATCH_MAX];
+  const uint8_t *in[KEM_BATCH_MAX], *m[KEM_BATCH_MAX];
+  const uint8_t *coins[KEM_BATCH_MAX], *pkx[KEM_BATCH_MAX];
+
+  if(n > KEM_BATCH_MAX)
+    return -1;
+
+  for(i=0;i<nenc;i++)
+    randombytes(buf[i], KYBER_SYMBYTES);
+  /* Don't release system RNG output */
+  for(i=0;i<nenc;i++) {
+    out[i] = buf[i];
+    in[i] = buf[i];
+  }
+  hash_batch(out, in, KYBER_SYMBYTES, nenc, BATCH_H);
+
+  /* Multitarget countermeasure for coins + contributory KEM */
+  for(i=0;i<nenc;i++)
+    out[i] = buf[i]+KYBER_SYMBYTES;
+  hash_batch(out, pk, KYBER_PUBLICKEYBYTES, nenc, BATCH_H);
+
+  for(d=0;d<ndec;d++) {
+    indcpa_dec(buf[nenc+d], ct_dec[d], sk[d]);
+    memcpy(buf[nenc+d]+KYBER_SYMBYTES,
+           sk[d]+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, KYBER_SYMBYTES);
+  }
+
+  for(i=0;i<n;i++) {
+    out[i] = kr[i];
+    in[i] = buf[i];
+  }
+  hash_batch(out, in, 2*KYBER_SYMBYTES, n, BATCH_G);
+
+  /* coins are in kr+KYBER_SYMBYTES */
+  for(i=0;i<n;i++) {
+    m[i] = buf[i];
+    coins[i] = kr[i]+KYBER_SYMBYTES;
+    c[i] = (i < nenc) ? ct[i] : cmp[i-nenc];
+    pkx[i] = (i < nenc) ? pk[i] : sk[i-nenc]+KYBER_INDCPA_SECRETKEYBYTES;
+  }
+  indcpa_enc_batch(c, m, pkx, coins, n);
+
+  /* overwrite coins in kr with H(c) */
+  for(i=0;i<n;i++) {
+    out[i] = kr[i]+KYBER_SYMBYTES;
+    in[i] = (i < nenc) ? ct[i] : ct_dec[i-nenc];
+  }
+  hash_batch(out, in, KYBER_CIPHERTEXTBYTES, n, BATCH_H);
+
+  /* Overwrite pre-k with z on re-encryption failure */
+  for(d=0;d<ndec;d++) {
+    fail = verify(ct_dec[d], cmp[d], KYBER_CIPHERTEXTBYTES);
+    cmov(kr[nenc+d], sk[d]+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES, fail);
+  }
+
+  /* hash concatenation of pre-k and H(c) to k */
+  for(i=0;i<n;i++) {
+    out[i] = (i < nenc) ? ss_enc[i] : ss_dec[i-nenc];
+    in[i] = kr[i];
+  }
+  hash_batch(out, in, 2*KYBER_SYMBYTES, n, BATCH_KDF);
+  return 0;
+}
@@ -16,4 +16,16 @@ int crypto_kem_dec(unsigned char *ss,
                    const unsigned char *ct,
                    const unsigned char *sk);
 
+#define KEM_BATCH_MAX 4
+
+#define crypto_kem_batch KYBER_NAMESPACE(_batch)
+int crypto_kem_batch(unsigned char *ct[],
+                     unsigned char *ss_enc[],
+                     const unsigned char *pk[],
+                     unsigned int nenc,
+                     unsigned char *ss_dec[],
+                     const unsigned char *ct_dec[],
+                     const unsigned char *sk[],
+                     unsigned int ndec);
+
 #endif
@@ -0,0 +1,167 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "params.h"
+#include "kex.h"
+#include "kem.h"
+#include "symmetric.h"
+
+/* The encapsulations and decapsulations of one step are independent of
+ * each other and run as one crypto_kem_batch, which shares the 4-way
+ * Keccak between their hashes and matrix expansions. */
+
+/*************************************************
+* Name:        kex_uake_initA
+*
+* Description: First message of the unilaterally authenticated key
+*              exchange: fresh ephemeral key pair of A and an
+*              encapsulation to the static public key of B
+*
+* Arguments:   - uint8_t *send:      pointer to output message
+*                                    (of length KEX_UAKE_SENDABYTES)
+*              - uint8_t *tk:        pointer to output temporary key
+*                                    (of length KYBER_SSBYTES), kept by A
+*              - uint8_t *sk:        pointer to output ephemeral secret key
+*                                    (of length KYBER_SECRETKEYBYTES), kept by A
+*              - const uint8_t *pkb: pointer to input static public key of B
+**************************************************/
+void kex_uake_initA(uint8_t *send,
+                    uint8_t *tk,
+                    uint8_t *sk,
+                    const uint8_t *pkb)
+{
+  crypto_kem_keypair(send, sk);
+  crypto_kem_enc(send+KYBER_PUBLICKEYBYTES, tk, pkb);
+}
+
+/*************************************************
+* Name:        kex_uake_sharedB
+*
+* Description: Response of B: encapsulation to the ephemeral public key
+*              of A and decapsulation with the static secret key of B
+*
+* Arguments:   - uint8_t *send:       pointer to output message
+*                                     (of length KEX_UAKE_SENDBBYTES)
+*              - uint8_t *k:          pointer to output shared key
+*                                     (of length KEX_SSBYTES)
+*              - const uint8_t *recv: pointer to input message of A
+*              - const uint8_t *skb:  pointer to input static secret key of B
+**************************************************/
+void kex_uake_sharedB(uint8_t *send,
+                      uint8_t *k,
+                      const uint8_t *recv,
+                      const uint8_t *skb)
+{
+  uint8_t buf[2*KYBER_SSBYTES];
+  uint8_t *ct[1] = {send}, *ss_enc[1] = {buf}, *ss_dec[1] = {buf+KYBER_SSBYTES};
+  const uint8_t *pk[1] = {recv}, *ct_dec[1] = {recv+KYBER_PUBLICKEYBYTES};
+  const uint8_t *sk[1] = {skb};
+
+  crypto_kem_batch(ct, ss_enc, pk, 1, ss_dec, ct_dec, sk, 1);
+  kdf(k, buf, 2*KYBER_SSBYTES);
+}
+
+/*************************************************
+* Name:        kex_uake_sharedA
+*
+* Description: Final step of A: decapsulation with the ephemeral
+*              secret key
+*
+* Arguments:   - uint8_t *k:          pointer to output shared key
+*                                     (of length KEX_SSBYTES)
+*              - const uint8_t *recv: pointer to input message of B
+*              - const uint8_t *tk:   pointer to input temporary key
+*              - const uint8_t *sk:   pointer to input ephemeral secret key
+**************************************************/
+void kex_uake_sharedA(uint8_t *k,
+                      const uint8_t *recv,
+                      const uint8_t *tk,
+                      const uint8_t *sk)
+{
+  unsigned int i;
+  uint8_t buf[2*KYBER_SSBYTES];
+
+  crypto_kem_dec(buf, recv, sk);
+  for(i=0;i<KYBER_SSBYTES;i++)
+    buf[i+KYBER_SSBYTES] = tk[i];
+  kdf(k, buf, 2*KYBER_SSBYTES);
+}
+
+/*************************************************
+* Name:        kex_ake_initA
+*
+* Description: First message of the mutually authenticated key
+*              exchange; identical to kex_uake_initA
+*
+* Arguments:   see kex_uake_initA
+**************************************************/
+void kex_ake_initA(uint8_t *send,
+                   uint8_t *tk,
+                   uint8_t *sk,
+                   const uint8_t *pkb)
+{
+  crypto_kem_keypair(send, sk);
+  crypto_kem_enc(send+KYBER_PUBLICKEYBYTES, tk, pkb);
+}
+
+/*************************************************
+* Name:        kex_ake_sharedB
+*
+* Description: Response of B: encapsulations to the ephemeral and to the
+*              static public key of A, decapsulation with the static
+*              secret key of B
+*
+* Arguments:   - uint8_t *send:       pointer to output message
+*                                     (of length KEX_AKE_SENDBBYTES)
+*              - uint8_t *k:          pointer to output shared key
+*                                     (of length KEX_SSBYTES)
+*              - const uint8_t *recv: pointer to input message of A
+*              - const uint8_t *skb:  pointer to input static secret key of B
+*              - const uint8_t *pka:  pointer to input static public key of A
+**************************************************/
+void kex_ake_sharedB(uint8_t *send,
+                     uint8_t *k,
+                     const uint8_t *recv,
+                     const uint8_t *skb,
+                     const uint8_t *pka)
+{
+  uint8_t buf[3*KYBER_SSBYTES];
+  uint8_t *ct[2] = {send, send+KYBER_CIPHERTEXTBYTES};
+  uint8_t *ss_enc[2] = {buf, buf+KYBER_SSBYTES};
+  uint8_t *ss_dec[1] = {buf+2*KYBER_SSBYTES};
+  const uint8_t *pk[2] = {recv, pka}, *ct_dec[1] = {recv+KYBER_PUBLICKEYBYTES};
+  const uint8_t *sk[1] = {skb};
+
+  crypto_kem_batch(ct, ss_enc, pk, 2, ss_dec, ct_dec, sk, 1);
+  kdf(k, buf, 3*KYBER_SSBYTES);
+}
+
+/*************************************************
+* Name:        kex_ake_sharedA
+*
+* Description: Final step of A: decapsulations with the ephemeral and
+*              with the static secret key of A
+*
+* Arguments:   - uint8_t *k:          pointer to output shared key
+*                                     (of length KEX_SSBYTES)
+*              - const uint8_t *recv: pointer to input message of B
+*              - const uint8_t *tk:   pointer to input temporary key
+*              - const uint8_t *sk:   pointer to input ephemeral secret key
+*              - const uint8_t *ska:  pointer to input static secret key of A
+**************************************************/
+void kex_ake_sharedA(uint8_t *k,
+                     const uint8_t *recv,
+                     const uint8_t *tk,
+                     const uint8_t *sk,
+                     const uint8_t *ska)
+{
+  unsigned int i;
+  uint8_t buf[3*KYBER_SSBYTES];
+  uint8_t *ss_dec[2] = {buf, buf+KYBER_SSBYTES};
+  const uint8_t *ct_dec[2] = {recv, recv+KYBER_CIPHERTEXTBYTES};
+  const uint8_t *skx[2] = {sk, ska};
+
+  crypto_kem_batch(NULL, NULL, NULL, 0, ss_dec, ct_dec, skx, 2);
+  for(i=0;i<KYBER_SSBYTES;i++)
+    buf[i+2*KYBER_SSBYTES] = tk[i];
+  kdf(k, buf, 3*KYBER_SSBYTES);
+}
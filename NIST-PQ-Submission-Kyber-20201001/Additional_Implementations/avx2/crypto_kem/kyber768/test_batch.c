@@ -0,0 +1,101 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "api.h"
+#include "kem.h"
+#include "rng.h"
+
+#define NTESTS 50
+
+static unsigned char pk[KEM_BATCH_MAX][CRYPTO_PUBLICKEYBYTES];
+static unsigned char sk[KEM_BATCH_MAX][CRYPTO_SECRETKEYBYTES];
+static unsigned char ct_dec[KEM_BATCH_MAX][CRYPTO_CIPHERTEXTBYTES];
+
+/*
+ * Runs nenc encapsulations and ndec decapsulations one after the other and
+ * as one crypto_kem_batch from the same DRBG state, and returns the number
+ * of outputs that differ. Every third decapsulated cipher text has a bit
+ * flipped, which takes the implicit rejection path.
+ */
+static unsigned int test_split(unsigned int it,
+                               unsigned int nenc,
+                               unsigned int ndec)
+{
+  unsigned int i, bad = 0;
+  unsigned char seed[48] = {0};
+  unsigned char key[CRYPTO_BYTES];
+  unsigned char ct_seq[KEM_BATCH_MAX][CRYPTO_CIPHERTEXTBYTES];
+  unsigned char ct_bat[KEM_BATCH_MAX][CRYPTO_CIPHERTEXTBYTES];
+  unsigned char ss_seq[KEM_BATCH_MAX][CRYPTO_BYTES];
+  unsigned char ss_bat[KEM_BATCH_MAX][CRYPTO_BYTES];
+  unsigned char sd_seq[KEM_BATCH_MAX][CRYPTO_BYTES];
+  unsigned char sd_bat[KEM_BATCH_MAX][CRYPTO_BYTES];
+  unsigned char *ct[KEM_BATCH_MAX], *ss_enc[KEM_BATCH_MAX];
+  unsigned char *ss_dec[KEM_BATCH_MAX];
+  const unsigned char *pkp[KEM_BATCH_MAX], *skp[KEM_BATCH_MAX];
+  const unsigned char *ctp[KEM_BATCH_MAX];
+
+  for(i=0;i<ndec;i++) {
+    crypto_kem_enc(ct_dec[i], key, pk[(i+it)%KEM_BATCH_MAX]);
+    if((i+it)%3 == 0)
+      ct_dec[i][it%CRYPTO_CIPHERTEXTBYTES] ^= 1;
+  }
+
+  seed[0] = it;
+  seed[1] = nenc;
+  seed[2] = ndec;
+  randombytes_init(seed, NULL, 256);
+  for(i=0;i<nenc;i++)
+    crypto_kem_enc(ct_seq[i], ss_seq[i], pk[(i+it+1)%KEM_BATCH_MAX]);
+  for(i=0;i<ndec;i++)
+    crypto_kem_dec(sd_seq[i], ct_dec[i], sk[(i+it)%KEM_BATCH_MAX]);
+
+  randombytes_init(seed, NULL, 256);
+  for(i=0;i<KEM_BATCH_MAX;i++) {
+    ct[i] = ct_bat[i];
+    ss_enc[i] = ss_bat[i];
+    ss_dec[i] = sd_bat[i];
+    pkp[i] = pk[(i+it+1)%KEM_BATCH_MAX];
+    skp[i] = sk[(i+it)%KEM_BATCH_MAX];
+    ctp[i] = ct_dec[i];
+  }
+  if(crypto_kem_batch(ct, ss_enc, pkp, nenc, ss_dec, ctp, skp, ndec))
+    return 1;
+
+  for(i=0;i<nenc;i++) {
+    bad += memcmp(ct_seq[i], ct_bat[i], CRYPTO_CIPHERTEXTBYTES) != 0;
+    bad += memcmp(ss_seq[i], ss_bat[i], CRYPTO_BYTES) != 0;
+  }
+  for(i=0;i<ndec;i++)
+    bad += memcmp(sd_seq[i], sd_bat[i], CRYPTO_BYTES) != 0;
+  return bad;
+}
+
+int main()
+{
+  unsigned int i, nenc, ndec, bad = 0;
+  unsigned char seed[48] = {0};
+  unsigned char *none[KEM_BATCH_MAX+1] = {NULL};
+  const unsigned char *cnone[KEM_BATCH_MAX+1] = {NULL};
+
+  randombytes_init(seed, NULL, 256);
+  for(i=0;i<KEM_BATCH_MAX;i++)
+    crypto_kem_keypair(pk[i], sk[i]);
+
+  for(i=0;i<NTESTS;i++)
+    for(nenc=0;nenc<=KEM_BATCH_MAX;nenc++)
+      for(ndec=0;nenc+ndec<=KEM_BATCH_MAX;ndec++)
+        bad += test_split(i, nenc, ndec);
+
+  if(crypto_kem_batch(none, none, cnone, KEM_BATCH_MAX, none, cnone, cnone, 1) != -1) {
+    printf("ERROR oversized batch accepted\n");
+    bad++;
+  }
+
+  if(bad) {
+    printf("ERROR %u batch outputs differ from sequential calls\n", bad);
+    return 1;
+  }
+  printf("%s: crypto_kem_batch matches sequential calls\n", CRYPTO_ALGNAME);
+  return 0;
+}
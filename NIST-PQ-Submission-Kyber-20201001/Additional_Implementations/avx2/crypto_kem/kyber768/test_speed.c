@@ -3,11 +3,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "api.h"
+#include "kem.h"
 #include "kex.h"
 #include "params.h"
 #include "indcpa.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "symmetric.h"
 #include "cpucycles.h"
 #include "speed_print.h"
 
@@ -28,6 +30,11 @@ int main()
   unsigned char kexsenda[KEX_AKE_SENDABYTES] = {0};
   unsigned char kexsendb[KEX_AKE_SENDBBYTES] = {0};
   unsigned char kexkey[KEX_SSBYTES] = {0};
+  unsigned char kexbuf[3*KYBER_SSBYTES];
+  unsigned char cts[KEM_BATCH_MAX][CRYPTO_CIPHERTEXTBYTES];
+  unsigned char sss[KEM_BATCH_MAX][CRYPTO_BYTES];
+  unsigned char *ctp[KEM_BATCH_MAX], *ssp[KEM_BATCH_MAX];
+  const unsigned char *pkp[KEM_BATCH_MAX];
   polyvec matrix[KYBER_K];
   poly ap;
 #ifndef KYBER_90S
@@ -178,5 +185,43 @@ int main()
   }
   print_results("kex_ake_sharedA: ", t, NTESTS);
 
+  /* The steps of the key exchange as separate KEM calls, for comparison
+   * with the batched versions above */
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_enc(kexsendb, kexbuf, kexsenda);
+    crypto_kem_dec(kexbuf+KYBER_SSBYTES, kexsenda+CRYPTO_PUBLICKEYBYTES, sk);
+    kdf(kexkey, kexbuf, 2*KYBER_SSBYTES);
+  }
+  print_results("kex_uake_sharedB sequential: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_enc(kexsendb, kexbuf, kexsenda);
+    crypto_kem_enc(kexsendb+CRYPTO_CIPHERTEXTBYTES, kexbuf+KYBER_SSBYTES, pk);
+    crypto_kem_dec(kexbuf+2*KYBER_SSBYTES, kexsenda+CRYPTO_PUBLICKEYBYTES, sk);
+    kdf(kexkey, kexbuf, 3*KYBER_SSBYTES);
+  }
+  print_results("kex_ake_sharedB sequential: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_dec(kexbuf, kexsendb, sk);
+    crypto_kem_dec(kexbuf+KYBER_SSBYTES, kexsendb+CRYPTO_CIPHERTEXTBYTES, sk);
+    kdf(kexkey, kexbuf, 3*KYBER_SSBYTES);
+  }
+  print_results("kex_ake_sharedA sequential: ", t, NTESTS);
+
+  for(i=0;i<KEM_BATCH_MAX;i++) {
+    ctp[i] = cts[i];
+    ssp[i] = sss[i];
+    pkp[i] = pk;
+  }
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_batch(ctp, ssp, pkp, KEM_BATCH_MAX, NULL, NULL, NULL, 0);
+  }
+  print_results("kyber_encaps batch of 4: ", t, NTESTS);
+
   return 0;
 }
@@ -0,0 +1,114 @@
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "cbd.h"
+#include "vec.h"
+
+/*
+ * Coefficient n of the output consumes the 2*eta bits starting at bit
+ * offset 2*eta*n of the input. A vector of VEC_LANES coefficients is
+ * therefore built by gathering the two bytes containing the field of each
+ * lane and shifting the field down to bit 0.
+ */
+#define CBD_IDX_LO(m,eta) ((2*(eta)*(m)) >> 3)
+#define CBD_IDX_HI(m,eta) (CBD_IDX_LO(m,eta) + 1)
+#define CBD_SHIFT(m,eta)  ((2*(eta)*(m)) & 7)
+
+#define cbd_load(x, buf, eta) do { \
+  vecu8 b_ = {0}; \
+  vecu8h lo_, hi_; \
+  memcpy(&b_, (buf), (eta)*VEC_LANES/4); \
+  lo_ = __builtin_shufflevector(b_, b_, VEC_LANEMAP(CBD_IDX_LO,eta)); \
+  hi_ = __builtin_shufflevector(b_, b_, VEC_LANEMAP(CBD_IDX_HI,eta)); \
+  (x)  = __builtin_convertvector(lo_, vecu16); \
+  (x) |= __builtin_convertvector(hi_, vecu16) << 8; \
+  (x) >>= (vecu16){VEC_LANEMAP(CBD_SHIFT,eta)}; \
+} while(0)
+
+/*************************************************
+* Name:        cbd_lanes
+*
+* Description: Lane-wise difference of the Hamming weights of the
+*              lower and upper eta bits of each lane
+*
+* Arguments:   - vecu16 x:         input bits, aligned to bit 0 of each lane
+*              - unsigned int eta: parameter of the binomial distribution
+*
+* Returns vector of coefficients in {-eta,...,eta}
+**************************************************/
+static inline vec16 cbd_lanes(vecu16 x, unsigned int eta)
+{
+  unsigned int i;
+  vecu16 a = {0}, b = {0};
+
+  for(i=0;i<eta;i++) {
+    a += (x >> i) & 1;
+    b += (x >> (eta+i)) & 1;
+  }
+  return (vec16)a - (vec16)b;
+}
+
+/*************************************************
+* Name:        cbd2
+*
+* Description: Given an array of uniformly random bytes, compute
+*              polynomial with coefficients distributed according to
+*              a centered binomial distribution with parameter eta=2
+*
+* Arguments:   - poly *r:            pointer to output polynomial
+*              - const uint8_t *buf: pointer to input byte array
+**************************************************/
+static void cbd2(poly *r, const uint8_t buf[2*KYBER_N/4])
+{
+  unsigned int i;
+  vecu16 x;
+
+  for(i=0;i<KYBER_N;i+=VEC_LANES) {
+    cbd_load(x, buf + 2*i/4, 2);
+    vec_store(r->coeffs + i, cbd_lanes(x, 2));
+  }
+}
+
+/*************************************************
+* Name:        cbd3
+*
+* Description: Given an array of uniformly random bytes, compute
+*              polynomial with coefficients distributed according to
+*              a centered binomial distribution with parameter eta=3
+*              This function is only needed for Kyber-512
+*
+* Arguments:   - poly *r:            pointer to output polynomial
+*              - const uint8_t *buf: pointer to input byte array
+**************************************************/
+#if KYBER_ETA1 == 3
+static void cbd3(poly *r, const uint8_t buf[3*KYBER_N/4])
+{
+  unsigned int i;
+  vecu16 x;
+
+  for(i=0;i<KYBER_N;i+=VEC_LANES) {
+    cbd_load(x, buf + 3*i/4, 3);
+    vec_store(r->coeffs + i, cbd_lanes(x, 3));
+  }
+}
+#endif
+
+void cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4])
+{
+#if KYBER_ETA1 == 2
+  cbd2(r, buf);
+#elif KYBER_ETA1 == 3
+  cbd3(r, buf);
+#else
+#error "This implementation requires eta1 in {2,3}"
+#endif
+}
+
+void cbd_eta2(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4])
+{
+#if KYBER_ETA2 != 2
+#error "This implementation requires eta2 = 2"
+#else
+  cbd2(r, buf);
+#endif
+}
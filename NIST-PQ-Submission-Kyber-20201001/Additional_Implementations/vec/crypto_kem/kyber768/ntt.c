@@ -0,0 +1,247 @@
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "ntt.h"
+#include "reduce.h"
+
+/* Code to generate zetas and zetas_inv used in the number-theoretic transform:
+
+#define KYBER_ROOT_OF_UNITY 17
+
+static const uint16_t tree[128] = {
+  0, 64, 32, 96, 16, 80, 48, 112, 8, 72, 40, 104, 24, 88, 56, 120,
+  4, 68, 36, 100, 20, 84, 52, 116, 12, 76, 44, 108, 28, 92, 60, 124,
+  2, 66, 34, 98, 18, 82, 50, 114, 10, 74, 42, 106, 26, 90, 58, 122,
+  6, 70, 38, 102, 22, 86, 54, 118, 14, 78, 46, 110, 30, 94, 62, 126,
+  1, 65, 33, 97, 17, 81, 49, 113, 9, 73, 41, 105, 25, 89, 57, 121,
+  5, 69, 37, 101, 21, 85, 53, 117, 13, 77, 45, 109, 29, 93, 61, 125,
+  3, 67, 35, 99, 19, 83, 51, 115, 11, 75, 43, 107, 27, 91, 59, 123,
+  7, 71, 39, 103, 23, 87, 55, 119, 15, 79, 47, 111, 31, 95, 63, 127
+};
+
+void init_ntt() {
+  unsigned int i, j, k;
+  int16_t tmp[128];
+
+  tmp[0] = MONT;
+  for(i = 1; i < 128; ++i)
+    tmp[i] = fqmul(tmp[i-1], KYBER_ROOT_OF_UNITY*MONT % KYBER_Q);
+
+  for(i = 0; i < 128; ++i)
+    zetas[i] = tmp[tree[i]];
+
+  k = 0;
+  for(i = 64; i >= 1; i >>= 1)
+    for(j = i; j < 2*i; ++j)
+      zetas_inv[k++] = -tmp[128 - tree[j]];
+
+  zetas_inv[127] = MONT * (MONT * (KYBER_Q - 1) * ((KYBER_Q - 1)/128) % KYBER_Q) % KYBER_Q;
+}
+
+*/
+
+const int16_t zetas[128] = {
+  2285, 2571, 2970, 1812, 1493, 1422, 287, 202, 3158, 622, 1577, 182, 962,
+  2127, 1855, 1468, 573, 2004, 264, 383, 2500, 1458, 1727, 3199, 2648, 1017,
+  732, 608, 1787, 411, 3124, 1758, 1223, 652, 2777, 1015, 2036, 1491, 3047,
+  1785, 516, 3321, 3009, 2663, 1711, 2167, 126, 1469, 2476, 3239, 3058, 830,
+  107, 1908, 3082, 2378, 2931, 961, 1821, 2604, 448, 2264, 677, 2054, 2226,
+  430, 555, 843, 2078, 871, 1550, 105, 422, 587, 177, 3094, 3038, 2869, 1574,
+  1653, 3083, 778, 1159, 3182, 2552, 1483, 2727, 1119, 1739, 644, 2457, 349,
+  418, 329, 3173, 3254, 817, 1097, 603, 610, 1322, 2044, 1864, 384, 2114, 3193,
+  1218, 1994, 2455, 220, 2142, 1670, 2144, 1799, 2051, 794, 1819, 2475, 2459,
+  478, 3221, 3021, 996, 991, 958, 1869, 1522, 1628
+};
+
+const int16_t zetas_inv[128] = {
+  1701, 1807, 1460, 2371, 2338, 2333, 308, 108, 2851, 870, 854, 1510, 2535,
+  1278, 1530, 1185, 1659, 1187, 3109, 874, 1335, 2111, 136, 1215, 2945, 1465,
+  1285, 2007, 2719, 2726, 2232, 2512, 75, 156, 3000, 2911, 2980, 872, 2685,
+  1590, 2210, 602, 1846, 777, 147, 2170, 2551, 246, 1676, 1755, 460, 291, 235,
+  3152, 2742, 2907, 3224, 1779, 2458, 1251, 2486, 2774, 2899, 1103, 1275, 2652,
+  1065, 2881, 725, 1508, 2368, 398, 951, 247, 1421, 3222, 2499, 271, 90, 853,
+  1860, 3203, 1162, 1618, 666, 320, 8, 2813, 1544, 282, 1838, 1293, 2314, 552,
+  2677, 2106, 1571, 205, 2918, 1542, 2721, 2597, 2312, 681, 130, 1602, 1871,
+  829, 2946, 3065, 1325, 2756, 1861, 1474, 1202, 2367, 3147, 1752, 2707, 171,
+  3127, 3042, 1907, 1836, 1517, 359, 758, 1441
+};
+
+/*
+ * zetas[64+i] and -zetas[64+i] interleaved, i.e., the constants of the
+ * KYBER_N/2 base multiplications in the order of the coefficient pairs
+ */
+const int16_t zetas_basemul[128] = {
+  2226, -2226, 430, -430, 555, -555, 843, -843, 2078, -2078, 871, -871, 1550,
+  -1550, 105, -105, 422, -422, 587, -587, 177, -177, 3094, -3094, 3038, -3038,
+  2869, -2869, 1574, -1574, 1653, -1653, 3083, -3083, 778, -778, 1159, -1159,
+  3182, -3182, 2552, -2552, 1483, -1483, 2727, -2727, 1119, -1119, 1739,
+  -1739, 644, -644, 2457, -2457, 349, -349, 418, -418, 329, -329, 3173, -3173,
+  3254, -3254, 817, -817, 1097, -1097, 603, -603, 610, -610, 1322, -1322,
+  2044, -2044, 1864, -1864, 384, -384, 2114, -2114, 3193, -3193, 1218, -1218,
+  1994, -1994, 2455, -2455, 220, -220, 2142, -2142, 1670, -1670, 2144, -2144,
+  1799, -1799, 2051, -2051, 794, -794, 1819, -1819, 2475, -2475, 2459, -2459,
+  478, -478, 3221, -3221, 3021, -3021, 996, -996, 991, -991, 958, -958, 1869,
+  -1869, 1522, -1522, 1628, -1628
+};
+
+/*
+ * Layers with butterfly distance len < VEC_LANES work on pairs of vectors
+ * that are split into the lower and upper halves of their 2*len blocks,
+ * so each lane needs the zeta of its own block.
+ */
+#define VEC_IDX_BLOCK(m,len) ((m)/(len))
+
+#define zetas_blockwise(zeta, z, len) do { \
+  vec16 z_ = {0}; \
+  memcpy(&z_, (z), VEC_LANES/(len)*sizeof(int16_t)); \
+  (zeta) = __builtin_shufflevector(z_, z_, VEC_LANEMAP(VEC_IDX_BLOCK,len)); \
+} while(0)
+
+#define NTT_SPLIT_LAYER(r, k, len) do { \
+  unsigned int j_; \
+  vec16 a_, b_, lo_, hi_, t_, zeta_; \
+  for(j_ = 0; j_ < 256; j_ += 2*VEC_LANES) { \
+    zetas_blockwise(zeta_, zetas + (k), len); \
+    (k) += VEC_LANES/(len); \
+    vec_split(lo_, hi_, vec_load((r)+j_), vec_load((r)+j_+VEC_LANES), len); \
+    t_ = vec_fqmul(zeta_, hi_); \
+    hi_ = lo_ - t_; \
+    lo_ = lo_ + t_; \
+    vec_merge(a_, b_, lo_, hi_, len); \
+    vec_store((r)+j_, a_); \
+    vec_store((r)+j_+VEC_LANES, b_); \
+  } \
+} while(0)
+
+#define INVNTT_SPLIT_LAYER(r, k, len) do { \
+  unsigned int j_; \
+  vec16 a_, b_, lo_, hi_, t_, zeta_; \
+  for(j_ = 0; j_ < 256; j_ += 2*VEC_LANES) { \
+    zetas_blockwise(zeta_, zetas_inv + (k), len); \
+    (k) += VEC_LANES/(len); \
+    vec_split(lo_, hi_, vec_load((r)+j_), vec_load((r)+j_+VEC_LANES), len); \
+    t_ = lo_; \
+    lo_ = vec_barrett_reduce(t_ + hi_); \
+    hi_ = vec_fqmul(zeta_, t_ - hi_); \
+    vec_merge(a_, b_, lo_, hi_, len); \
+    vec_store((r)+j_, a_); \
+    vec_store((r)+j_+VEC_LANES, b_); \
+  } \
+} while(0)
+
+/*************************************************
+* Name:        ntt
+*
+* Description: Inplace number-theoretic transform (NTT) in Rq
+*              input is in standard order, output is in bitreversed order;
+*              vectorized, same output as the reference implementation
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void ntt(int16_t r[256]) {
+  unsigned int len, start, j, k;
+  vec16 a, b, t, zeta;
+
+  k = 1;
+  for(len = 128; len >= VEC_LANES; len >>= 1) {
+    for(start = 0; start < 256; start += 2*len) {
+      zeta = vec_set1(zetas[k++]);
+      for(j = start; j < start + len; j += VEC_LANES) {
+        a = vec_load(r + j);
+        b = vec_load(r + j + len);
+        t = vec_fqmul(zeta, b);
+        vec_store(r + j + len, a - t);
+        vec_store(r + j, a + t);
+      }
+    }
+  }
+
+#if VEC_LANES > 16
+  NTT_SPLIT_LAYER(r, k, 16);
+#endif
+#if VEC_LANES > 8
+  NTT_SPLIT_LAYER(r, k, 8);
+#endif
+  NTT_SPLIT_LAYER(r, k, 4);
+  NTT_SPLIT_LAYER(r, k, 2);
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inplace inverse number-theoretic transform in Rq and
+*              multiplication by Montgomery factor 2^16.
+*              Input is in bitreversed order, output is in standard order;
+*              vectorized, same output as the reference implementation
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void invntt(int16_t r[256]) {
+  unsigned int start, len, j, k;
+  vec16 a, b, t, zeta;
+
+  k = 0;
+  INVNTT_SPLIT_LAYER(r, k, 2);
+  INVNTT_SPLIT_LAYER(r, k, 4);
+#if VEC_LANES > 8
+  INVNTT_SPLIT_LAYER(r, k, 8);
+#endif
+#if VEC_LANES > 16
+  INVNTT_SPLIT_LAYER(r, k, 16);
+#endif
+
+  for(len = VEC_LANES; len <= 128; len <<= 1) {
+    for(start = 0; start < 256; start += 2*len) {
+      zeta = vec_set1(zetas_inv[k++]);
+      for(j = start; j < start + len; j += VEC_LANES) {
+        a = vec_load(r + j);
+        b = vec_load(r + j + len);
+        t = a;
+        a = vec_barrett_reduce(t + b);
+        b = vec_fqmul(zeta, t - b);
+        vec_store(r + j, a);
+        vec_store(r + j + len, b);
+      }
+    }
+  }
+
+  zeta = vec_set1(zetas_inv[127]);
+  for(j = 0; j < 256; j += VEC_LANES)
+    vec_store(r + j, vec_fqmul(vec_load(r + j), zeta));
+}
+
+/*************************************************
+* Name:        basemul
+*
+* Description: Multiplication of polynomials in NTT domain, i.e.,
+*              the KYBER_N/2 multiplications in Zq[X]/(X^2-zeta)
+*              of all coefficient pairs; vectorized over the pairs
+*
+* Arguments:   - int16_t r[256]:       pointer to the output polynomial
+*              - const int16_t a[256]: pointer to the first factor
+*              - const int16_t b[256]: pointer to the second factor
+**************************************************/
+void basemul(int16_t r[256], const int16_t a[256], const int16_t b[256])
+{
+  unsigned int i;
+  vec16 a0, a1, b0, b1, r0, r1, zeta;
+
+  for(i = 0; i < 256; i += 2*VEC_LANES) {
+    vec_split(a0, a1, vec_load(a + i), vec_load(a + i + VEC_LANES), 1);
+    vec_split(b0, b1, vec_load(b + i), vec_load(b + i + VEC_LANES), 1);
+    zeta = vec_load(zetas_basemul + i/2);
+
+    r0  = vec_fqmul(a1, b1);
+    r0  = vec_fqmul(r0, zeta);
+    r0 += vec_fqmul(a0, b0);
+
+    r1  = vec_fqmul(a0, b1);
+    r1 += vec_fqmul(a1, b0);
+
+    vec_merge(r0, r1, r0, r1, 1);
+    vec_store(r + i, r0);
+    vec_store(r + i + VEC_LANES, r1);
+  }
+}
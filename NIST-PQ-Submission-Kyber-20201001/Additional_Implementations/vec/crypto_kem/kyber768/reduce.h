@@ -0,0 +1,82 @@
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <stdint.h>
+#include "params.h"
+#include "vec.h"
+
+#define MONT 2285 // 2^16 mod q
+#define QINV 62209 // q^-1 mod 2^16
+
+#define montgomery_reduce KYBER_NAMESPACE(_montgomery_reduce)
+int16_t montgomery_reduce(int32_t a);
+
+#define barrett_reduce KYBER_NAMESPACE(_barrett_reduce)
+int16_t barrett_reduce(int16_t a);
+
+#define csubq KYBER_NAMESPACE(_csubq)
+int16_t csubq(int16_t x);
+
+/*************************************************
+* Name:        vec_montgomery_reduce
+*
+* Description: Lane-wise Montgomery reduction of the 32-bit integers
+*              given by their low and high 16-bit halves; computes
+*              (hi*2^16 + lo) * R^-1 mod q with the same output as
+*              montgomery_reduce
+*
+* Arguments:   - vec16 lo: low halves of the inputs
+*              - vec16 hi: high halves of the inputs
+*
+* Returns:     vector with lanes in {-q+1,...,q-1}
+**************************************************/
+static inline vec16 vec_montgomery_reduce(vec16 lo, vec16 hi)
+{
+  vec16 u;
+  u = vec_mullo(lo, vec_set1((int16_t)QINV));
+  return hi - vec_mulhi(u, vec_set1(KYBER_Q));
+}
+
+/*************************************************
+* Name:        vec_fqmul
+*
+* Description: Lane-wise multiplication followed by Montgomery reduction
+*
+* Returns:     vector with lanes congruent to a*b*R^{-1} mod q
+**************************************************/
+static inline vec16 vec_fqmul(vec16 a, vec16 b)
+{
+  return vec_montgomery_reduce(vec_mullo(a, b), vec_mulhi(a, b));
+}
+
+/*************************************************
+* Name:        vec_barrett_reduce
+*
+* Description: Lane-wise Barrett reduction; same output as barrett_reduce
+*
+* Returns:     vector with lanes in {0,...,q} congruent to a modulo q
+**************************************************/
+static inline vec16 vec_barrett_reduce(vec16 a)
+{
+  vec16 t;
+  const int16_t v = ((1U << 26) + KYBER_Q/2)/KYBER_Q;
+
+  t = vec_mulhi(a, vec_set1(v)) >> 10;
+  return a - vec_mullo(t, vec_set1(KYBER_Q));
+}
+
+/*************************************************
+* Name:        vec_csubq
+*
+* Description: Lane-wise conditional subtraction of q
+*
+* Returns:     a - q in lanes where a >= q, else a
+**************************************************/
+static inline vec16 vec_csubq(vec16 a)
+{
+  a -= KYBER_Q;
+  a += (a >> 15) & KYBER_Q;
+  return a;
+}
+
+#endif
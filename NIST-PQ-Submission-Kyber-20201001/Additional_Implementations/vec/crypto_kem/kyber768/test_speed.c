@@ -0,0 +1,89 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "api.h"
+#include "params.h"
+#include "indcpa.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "cpucycles.h"
+#include "speed_print.h"
+
+#define NTESTS 10000
+
+uint64_t t[NTESTS];
+uint8_t seed[KYBER_SYMBYTES] = {0};
+
+int main()
+{
+  unsigned int i;
+  unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+  unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+  unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
+  unsigned char key[CRYPTO_BYTES] = {0};
+  polyvec matrix[KYBER_K];
+  poly ap;
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    gen_matrix(matrix, seed, 0);
+  }
+  print_results("gen_a: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_getnoise_eta1(&ap, seed, 0);
+  }
+  print_results("poly_getnoise_eta1: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_getnoise_eta2(&ap, seed, 0);
+  }
+  print_results("poly_getnoise_eta2: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_ntt(&ap);
+  }
+  print_results("NTT: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_invntt_tomont(&ap);
+  }
+  print_results("INVNTT: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_basemul_montgomery(&ap, &matrix[0].vec[0], &matrix[0].vec[1]);
+  }
+  print_results("poly_basemul_montgomery: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    poly_reduce(&ap);
+  }
+  print_results("poly_reduce: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_keypair(pk, sk);
+  }
+  print_results("kyber_keypair: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_enc(ct, key, pk);
+  }
+  print_results("kyber_encaps: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_dec(key, ct, sk);
+  }
+  print_results("kyber_decaps: ", t, NTESTS);
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+#ifndef VEC_H
+#define VEC_H
+
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Portable SIMD layer built on GCC/Clang vector extensions.
+ * The register width is fixed at build time through KYBER_VECBYTES:
+ *   16: SSE2/SSE4.1, NEON
+ *   32: AVX2
+ *   64: AVX-512BW
+ */
+#ifndef KYBER_VECBYTES
+#define KYBER_VECBYTES 16
+#endif
+
+#if (KYBER_VECBYTES != 16) && (KYBER_VECBYTES != 32) && (KYBER_VECBYTES != 64)
+#error "KYBER_VECBYTES must be in {16,32,64}"
+#endif
+
+/*
+ * Vectors wider than the enabled ISA are split by the compiler and change
+ * the calling convention of the inline helpers (-Wpsabi).
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#if (KYBER_VECBYTES == 32) && !defined(__AVX2__)
+#error "KYBER_VECBYTES=32 needs AVX2 (-mavx2)"
+#endif
+#if (KYBER_VECBYTES == 64) && !defined(__AVX512BW__)
+#error "KYBER_VECBYTES=64 needs AVX-512BW (-mavx512bw)"
+#endif
+#endif
+
+#if !defined(__BYTE_ORDER__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "The vec implementation assumes a little-endian target"
+#endif
+
+#define VEC_LANES (KYBER_VECBYTES/2)
+
+typedef int16_t vec16 __attribute__((vector_size(KYBER_VECBYTES)));
+typedef uint16_t vecu16 __attribute__((vector_size(KYBER_VECBYTES)));
+typedef uint8_t vecu8 __attribute__((vector_size(KYBER_VECBYTES)));
+typedef uint8_t vecu8h __attribute__((vector_size(KYBER_VECBYTES/2)));
+typedef int32_t vec32 __attribute__((vector_size(2*KYBER_VECBYTES)));
+
+/*
+ * VEC_LANEMAP(F,x) expands to F(0,x),F(1,x),...,F(VEC_LANES-1,x) and is
+ * used to build the constant index lists of __builtin_shufflevector.
+ */
+#define VEC_MAP8(F,x,o) F((o)+0,x),F((o)+1,x),F((o)+2,x),F((o)+3,x), \
+                        F((o)+4,x),F((o)+5,x),F((o)+6,x),F((o)+7,x)
+#if KYBER_VECBYTES == 16
+#define VEC_LANEMAP(F,x) VEC_MAP8(F,x,0)
+#elif KYBER_VECBYTES == 32
+#define VEC_LANEMAP(F,x) VEC_MAP8(F,x,0),VEC_MAP8(F,x,8)
+#else
+#define VEC_LANEMAP(F,x) VEC_MAP8(F,x,0),VEC_MAP8(F,x,8), \
+                         VEC_MAP8(F,x,16),VEC_MAP8(F,x,24)
+#endif
+
+/*
+ * Index lists for splitting the concatenation (a,b) into the lower and
+ * upper halves of all blocks of 2*len consecutive coefficients, and for
+ * merging them back. These are the data movements of the NTT layers with
+ * butterfly distance len < VEC_LANES.
+ */
+#define VEC_IDX_LO(m,len) (((m)/(len))*2*(len) + (m)%(len))
+#define VEC_IDX_HI(m,len) (VEC_IDX_LO(m,len) + (len))
+#define VEC_IDX_MERGE(n,len) \
+  ((((n)%(2*(len))) < (len)) \
+   ? ((n)/(2*(len)))*(len) + (n)%(2*(len)) \
+   : VEC_LANES + ((n)/(2*(len)))*(len) + (n)%(2*(len)) - (len))
+#define VEC_IDX_MERGE_HI(n,len) VEC_IDX_MERGE((n)+VEC_LANES,len)
+
+#define vec_split(lo,hi,a,b,len) do { \
+  vec16 vec_split_a_ = (a), vec_split_b_ = (b); \
+  (lo) = __builtin_shufflevector(vec_split_a_, vec_split_b_, \
+                                 VEC_LANEMAP(VEC_IDX_LO,len)); \
+  (hi) = __builtin_shufflevector(vec_split_a_, vec_split_b_, \
+                                 VEC_LANEMAP(VEC_IDX_HI,len)); \
+} while(0)
+
+#define vec_merge(a,b,lo,hi,len) do { \
+  vec16 vec_merge_lo_ = (lo), vec_merge_hi_ = (hi); \
+  (a) = __builtin_shufflevector(vec_merge_lo_, vec_merge_hi_, \
+                                VEC_LANEMAP(VEC_IDX_MERGE,len)); \
+  (b) = __builtin_shufflevector(vec_merge_lo_, vec_merge_hi_, \
+                                VEC_LANEMAP(VEC_IDX_MERGE_HI,len)); \
+} while(0)
+
+static inline vec16 vec_load(const int16_t *a)
+{
+  vec16 r;
+  memcpy(&r, a, sizeof(r));
+  return r;
+}
+
+static inline void vec_store(int16_t *r, vec16 a)
+{
+  memcpy(r, &a, sizeof(a));
+}
+
+static inline vec16 vec_set1(int16_t a)
+{
+  return (vec16){0} + a;
+}
+
+/*************************************************
+* Name:        vec_mullo
+*
+* Description: Lane-wise low half of the 32-bit product, modulo 2^16
+**************************************************/
+static inline vec16 vec_mullo(vec16 a, vec16 b)
+{
+  return (vec16)((vecu16)a * (vecu16)b);
+}
+
+/*************************************************
+* Name:        vec_mulhi
+*
+* Description: Lane-wise high half of the signed 32-bit product.
+*              Vector extensions have no widening multiply, so the
+*              generic version multiplies in 32-bit lanes; x86 gets the
+*              native pmulhw of the selected width.
+**************************************************/
+static inline vec16 vec_mulhi(vec16 a, vec16 b)
+{
+#if KYBER_VECBYTES == 16 && defined(__SSE2__)
+  return (vec16)_mm_mulhi_epi16((__m128i)a, (__m128i)b);
+#elif KYBER_VECBYTES == 32 && defined(__AVX2__)
+  return (vec16)_mm256_mulhi_epi16((__m256i)a, (__m256i)b);
+#elif KYBER_VECBYTES == 64 && defined(__AVX512BW__)
+  return (vec16)_mm512_mulhi_epi16((__m512i)a, (__m512i)b);
+#else
+  vec32 p;
+  p  = __builtin_convertvector(a, vec32);
+  p *= __builtin_convertvector(b, vec32);
+  return __builtin_convertvector(p >> 16, vec16);
+#endif
+}
+
+#endif
@@ -1,45 +1,46 @@
 #include <stdint.h>
 #include "params.h"
 #include "cbd.h"
+#include "swar.h"
 
 /*************************************************
-* Name:        load32_littleendian
+* Name:        load64_littleendian
 *
-* Description: load 4 bytes into a 32-bit integer
+* Description: load 8 bytes into a 64-bit integer
 *              in little-endian order
 *
 * Arguments:   - const uint8_t *x: pointer to input byte array
 *
-* Returns 32-bit unsigned integer loaded from x
+* Returns 64-bit unsigned integer loaded from x
 **************************************************/
-static uint32_t load32_littleendian(const uint8_t x[4])
+static uint64_t load64_littleendian(const uint8_t x[8])
 {
-  uint32_t r;
-  r  = (uint32_t)x[0];
-  r |= (uint32_t)x[1] << 8;
-  r |= (uint32_t)x[2] << 16;
-  r |= (uint32_t)x[3] << 24;
+  unsigned int i;
+  uint64_t r = 0;
+  for(i=0;i<8;i++)
+    r |= (uint64_t)x[i] << 8*i;
   return r;
 }
 
 /*************************************************
-* Name:        load24_littleendian
+* Name:        load48_littleendian
 *
-* Description: load 3 bytes into a 32-bit integer
+* Description: load 6 bytes into a 64-bit integer
 *              in little-endian order
 *              This function is only needed for Kyber-512
 *
 * Arguments:   - const uint8_t *x: pointer to input byte array
 *
-* Returns 32-bit unsigned integer loaded from x (most significant byte is zero)
+* Returns 64-bit unsigned integer loaded from x (two most significant
+* bytes are zero)
 **************************************************/
 #if KYBER_ETA1 == 3
-static uint32_t load24_littleendian(const uint8_t x[3])
+static uint64_t load48_littleendian(const uint8_t x[6])
 {
-  uint32_t r;
-  r  = (uint32_t)x[0];
-  r |= (uint32_t)x[1] << 8;
-  r |= (uint32_t)x[2] << 16;
+  unsigned int i;
+  uint64_t r = 0;
+  for(i=0;i<6;i++)
+    r |= (uint64_t)x[i] << 8*i;
   return r;
 }
 #endif
@@ -58,18 +59,23 @@ static uint32_t load24_littleendian(const uint8_t x[3])
 static void cbd2(poly *r, const uint8_t buf[2*KYBER_N/4])
 {
   unsigned int i,j;
-  uint32_t t,d;
-  int16_t a,b;
+  uint64_t t,d,x;
 
-  for(i=0;i<KYBER_N/8;i++) {
-    t  = load32_littleendian(buf+4*i);
-    d  = t & 0x55555555;
-    d += (t>>1) & 0x55555555;
+  for(i=0;i<KYBER_N/16;i++) {
+    t  = load64_littleendian(buf+8*i);
+    d  = t & 0x5555555555555555ULL;
+    d += (t>>1) & 0x5555555555555555ULL;
+
+    /* a+4-b in every nibble, never borrows since a,b <= 2 */
+    d  = ((d & 0x3333333333333333ULL) | 0x4444444444444444ULL)
+       - ((d >> 2) & 0x3333333333333333ULL);
 
-    for(j=0;j<8;j++) {
-      a = (d >> (4*j+0)) & 0x3;
-      b = (d >> (4*j+2)) & 0x3;
-      r->coeffs[8*i+j] = a - b;
+    for(j=0;j<4;j++) {
+      /* spread 4 nibbles to 16-bit lanes and subtract the offset */
+      x = (d >> 16*j) & 0xFFFF;
+      x = (x | x << 24) & 0x000000FF000000FFULL;
+      x = (x | x << 12) & 0x000F000F000F000FULL;
+      swar_store(&r->coeffs[16*i+4*j], swar_sub(x, 4*SWAR_ONES));
     }
   }
 }
@@ -89,19 +95,24 @@ static void cbd2(poly *r, const uint8_t buf[2*KYBER_N/4])
 static void cbd3(poly *r, const uint8_t buf[3*KYBER_N/4])
 {
   unsigned int i,j;
-  uint32_t t,d;
-  int16_t a,b;
+  uint64_t t,d,x;
 
-  for(i=0;i<KYBER_N/4;i++) {
-    t  = load24_littleendian(buf+3*i);
-    d  = t & 0x00249249;
-    d += (t>>1) & 0x00249249;
-    d += (t>>2) & 0x00249249;
+  for(i=0;i<KYBER_N/8;i++) {
+    t  = load48_littleendian(buf+6*i);
+    d  = t & 0x249249249249ULL;
+    d += (t>>1) & 0x249249249249ULL;
+    d += (t>>2) & 0x249249249249ULL;
 
-    for(j=0;j<4;j++) {
-      a = (d >> (6*j+0)) & 0x7;
-      b = (d >> (6*j+3)) & 0x7;
-      r->coeffs[4*i+j] = a - b;
+    /* a+4-b in every 6-bit field, never borrows since a,b <= 3 */
+    d  = ((d & 0x1C71C71C71C7ULL) | 0x104104104104ULL)
+       - ((d >> 3) & 0x1C71C71C71C7ULL);
+
+    for(j=0;j<2;j++) {
+      /* spread 4 fields to 16-bit lanes and subtract the offset */
+      x = (d >> 24*j) & 0xFFFFFF;
+      x = (x | x << 20) & 0x00000FFF00000FFFULL;
+      x = (x | x << 10) & 0x003F003F003F003FULL;
+      swar_store(&r->coeffs[8*i+4*j], swar_sub(x, 4*SWAR_ONES));
     }
   }
 }
@@ -238,14 +238,13 @@ void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
   polyvec_ntt(&skpv);
   polyvec_ntt(&e);
 
-  // matrix-vector multiplication
+  // matrix-vector multiplication; poly_tomont accepts unreduced input
   for(i=0;i<KYBER_K;i++) {
-    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
+    polyvec_pointwise_acc_montgomery_lazy(&pkpv.vec[i], &a[i], &skpv);
     poly_tomont(&pkpv.vec[i]);
   }
 
-  polyvec_add(&pkpv, &pkpv, &e);
-  polyvec_reduce(&pkpv);
+  polyvec_add_reduce(&pkpv, &pkpv, &e);
 
   pack_sk(sk, &skpv);
   pack_pk(pk, &pkpv, publicseed);
@@ -300,11 +299,9 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
   polyvec_invntt_tomont(&bp);
   poly_invntt_tomont(&v);
 
-  polyvec_add(&bp, &bp, &ep);
+  polyvec_add_reduce(&bp, &bp, &ep);
   poly_add(&v, &v, &epp);
-  poly_add(&v, &v, &k);
-  polyvec_reduce(&bp);
-  poly_reduce(&v);
+  poly_add_reduce(&v, &v, &k);
 
   pack_ciphertext(c, &bp, &v);
 }
@@ -336,8 +333,7 @@ void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
   polyvec_pointwise_acc_montgomery(&mp, &skpv, &bp);
   poly_invntt_tomont(&mp);
 
-  poly_sub(&mp, &v, &mp);
-  poly_reduce(&mp);
+  poly_sub_reduce(&mp, &v, &mp);
 
   poly_tomsg(m, &mp);
 }
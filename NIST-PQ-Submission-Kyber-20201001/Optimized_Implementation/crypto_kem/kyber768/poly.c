@@ -5,11 +5,14 @@
 #include "reduce.h"
 #include "cbd.h"
 #include "symmetric.h"
+#include "swar.h"
 
 /*************************************************
 * Name:        poly_compress
 *
-* Description: Compression and subsequent serialization of a polynomial
+* Description: Compression and subsequent serialization of a polynomial;
+*              the conditional subtraction of q is fused into the packing
+*              loop, the input polynomial is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (of length KYBER_POLYCOMPRESSEDBYTES)
@@ -19,13 +22,14 @@ void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
 {
   unsigned int i,j;
   uint8_t t[8];
-
-  poly_csubq(a);
+  int16_t u[8];
 
 #if (KYBER_POLYCOMPRESSEDBYTES == 128)
   for(i=0;i<KYBER_N/8;i++) {
+    swar_store(u,   swar_csubq(swar_load(&a->coeffs[8*i])));
+    swar_store(u+4, swar_csubq(swar_load(&a->coeffs[8*i+4])));
     for(j=0;j<8;j++)
-      t[j] = ((((uint16_t)a->coeffs[8*i+j] << 4) + KYBER_Q/2)/KYBER_Q) & 15;
+      t[j] = ((((uint16_t)u[j] << 4) + KYBER_Q/2)/KYBER_Q) & 15;
 
     r[0] = t[0] | (t[1] << 4);
     r[1] = t[2] | (t[3] << 4);
@@ -35,8 +39,10 @@ void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
   }
 #elif (KYBER_POLYCOMPRESSEDBYTES == 160)
   for(i=0;i<KYBER_N/8;i++) {
+    swar_store(u,   swar_csubq(swar_load(&a->coeffs[8*i])));
+    swar_store(u+4, swar_csubq(swar_load(&a->coeffs[8*i+4])));
     for(j=0;j<8;j++)
-      t[j] = ((((uint32_t)a->coeffs[8*i+j] << 5) + KYBER_Q/2)/KYBER_Q) & 31;
+      t[j] = ((((uint32_t)(uint16_t)u[j] << 5) + KYBER_Q/2)/KYBER_Q) & 31;
 
     r[0] = (t[0] >> 0) | (t[1] << 5);
     r[1] = (t[1] >> 3) | (t[2] << 2) | (t[3] << 7);
@@ -95,7 +101,9 @@ void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES])
 /*************************************************
 * Name:        poly_tobytes
 *
-* Description: Serialization of a polynomial
+* Description: Serialization of a polynomial; the conditional subtraction
+*              of q is fused into the packing loop, the input polynomial
+*              is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (needs space for KYBER_POLYBYTES bytes)
@@ -103,17 +111,16 @@ void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES])
 **************************************************/
 void poly_tobytes(uint8_t r[KYBER_POLYBYTES], poly *a)
 {
-  unsigned int i;
-  uint16_t t0, t1;
-
-  poly_csubq(a);
+  unsigned int i,j;
+  uint64_t t;
 
-  for(i=0;i<KYBER_N/2;i++) {
-    t0 = a->coeffs[2*i];
-    t1 = a->coeffs[2*i+1];
-    r[3*i+0] = (t0 >> 0);
-    r[3*i+1] = (t0 >> 8) | (t1 << 4);
-    r[3*i+2] = (t1 >> 4);
+  for(i=0;i<KYBER_N/4;i++) {
+    t = swar_csubq(swar_load(&a->coeffs[4*i]));
+    /* squeeze four 12-bit lanes into the low 48 bits */
+    t = (t & 0x00000FFF00000FFFULL) | ((t >> 4) & 0x00FFF00000FFF000ULL);
+    t = (t & 0x0000000000FFFFFFULL) | ((t >> 8) & 0x0000FFFFFF000000ULL);
+    for(j=0;j<6;j++)
+      r[6*i+j] = t >> 8*j;
   }
 }
 
@@ -164,7 +171,8 @@ void poly_frommsg(poly *r, const uint8_t msg[KYBER_INDCPA_MSGBYTES])
 /*************************************************
 * Name:        poly_tomsg
 *
-* Description: Convert polynomial to 32-byte message
+* Description: Convert polynomial to 32-byte message;
+*              the input polynomial is left unchanged
 *
 * Arguments:   - uint8_t *msg: pointer to output message
 *              - poly *a:      pointer to input polynomial
@@ -173,13 +181,14 @@ void poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], poly *a)
 {
   unsigned int i,j;
   uint16_t t;
-
-  poly_csubq(a);
+  int16_t u[8];
 
   for(i=0;i<KYBER_N/8;i++) {
+    swar_store(u,   swar_csubq(swar_load(&a->coeffs[8*i])));
+    swar_store(u+4, swar_csubq(swar_load(&a->coeffs[8*i+4])));
     msg[i] = 0;
     for(j=0;j<8;j++) {
-      t = ((((uint16_t)a->coeffs[8*i+j] << 1) + KYBER_Q/2)/KYBER_Q) & 1;
+      t = ((((uint16_t)u[j] << 1) + KYBER_Q/2)/KYBER_Q) & 1;
       msg[i] |= t << j;
     }
   }
@@ -283,9 +292,8 @@ void poly_basemul_montgomery(poly *r, const poly *a, const poly *b)
 void poly_tomont(poly *r)
 {
   unsigned int i;
-  const int16_t f = (1ULL << 32) % KYBER_Q;
-  for(i=0;i<KYBER_N;i++)
-    r->coeffs[i] = montgomery_reduce((int32_t)r->coeffs[i]*f);
+  for(i=0;i<KYBER_N/4;i++)
+    swar_store(&r->coeffs[4*i], swar_tomont(swar_load(&r->coeffs[4*i])));
 }
 
 /*************************************************
@@ -299,8 +307,9 @@ void poly_tomont(poly *r)
 void poly_reduce(poly *r)
 {
   unsigned int i;
-  for(i=0;i<KYBER_N;i++)
-    r->coeffs[i] = barrett_reduce(r->coeffs[i]);
+  for(i=0;i<KYBER_N/4;i++)
+    swar_store(&r->coeffs[4*i],
+               swar_barrett_reduce(swar_load(&r->coeffs[4*i])));
 }
 
 /*************************************************
@@ -315,8 +324,8 @@ void poly_reduce(poly *r)
 void poly_csubq(poly *r)
 {
   unsigned int i;
-  for(i=0;i<KYBER_N;i++)
-    r->coeffs[i] = csubq(r->coeffs[i]);
+  for(i=0;i<KYBER_N/4;i++)
+    swar_store(&r->coeffs[4*i], swar_csubq(swar_load(&r->coeffs[4*i])));
 }
 
 /*************************************************
@@ -331,8 +340,9 @@ void poly_csubq(poly *r)
 void poly_add(poly *r, const poly *a, const poly *b)
 {
   unsigned int i;
-  for(i=0;i<KYBER_N;i++)
-    r->coeffs[i] = a->coeffs[i] + b->coeffs[i];
+  for(i=0;i<KYBER_N/4;i++)
+    swar_store(&r->coeffs[4*i], swar_add(swar_load(&a->coeffs[4*i]),
+                                         swar_load(&b->coeffs[4*i])));
 }
 
 /*************************************************
@@ -347,6 +357,49 @@ void poly_add(poly *r, const poly *a, const poly *b)
 void poly_sub(poly *r, const poly *a, const poly *b)
 {
   unsigned int i;
-  for(i=0;i<KYBER_N;i++)
-    r->coeffs[i] = a->coeffs[i] - b->coeffs[i];
+  for(i=0;i<KYBER_N/4;i++)
+    swar_store(&r->coeffs[4*i], swar_sub(swar_load(&a->coeffs[4*i]),
+                                         swar_load(&b->coeffs[4*i])));
+}
+
+/*************************************************
+* Name:        poly_add_reduce
+*
+* Description: Add two polynomials and apply Barrett reduction to the sum
+*              in the same pass; same output as poly_add followed by
+*              poly_reduce
+*
+* Arguments: - poly *r:       pointer to output polynomial
+*            - const poly *a: pointer to first input polynomial
+*            - const poly *b: pointer to second input polynomial
+**************************************************/
+void poly_add_reduce(poly *r, const poly *a, const poly *b)
+{
+  unsigned int i;
+  uint64_t t;
+  for(i=0;i<KYBER_N/4;i++) {
+    t = swar_add(swar_load(&a->coeffs[4*i]), swar_load(&b->coeffs[4*i]));
+    swar_store(&r->coeffs[4*i], swar_barrett_reduce(t));
+  }
+}
+
+/*************************************************
+* Name:        poly_sub_reduce
+*
+* Description: Subtract two polynomials and apply Barrett reduction to the
+*              difference in the same pass; same output as poly_sub
+*              followed by poly_reduce
+*
+* Arguments: - poly *r:       pointer to output polynomial
+*            - const poly *a: pointer to first input polynomial
+*            - const poly *b: pointer to second input polynomial
+**************************************************/
+void poly_sub_reduce(poly *r, const poly *a, const poly *b)
+{
+  unsigned int i;
+  uint64_t t;
+  for(i=0;i<KYBER_N/4;i++) {
+    t = swar_sub(swar_load(&a->coeffs[4*i]), swar_load(&b->coeffs[4*i]));
+    swar_store(&r->coeffs[4*i], swar_barrett_reduce(t));
+  }
 }
@@ -51,5 +51,9 @@ void poly_csubq(poly *r);
 void poly_add(poly *r, const poly *a, const poly *b);
 #define poly_sub KYBER_NAMESPACE(_poly_sub)
 void poly_sub(poly *r, const poly *a, const poly *b);
+#define poly_add_reduce KYBER_NAMESPACE(_poly_add_reduce)
+void poly_add_reduce(poly *r, const poly *a, const poly *b);
+#define poly_sub_reduce KYBER_NAMESPACE(_poly_sub_reduce)
+void poly_sub_reduce(poly *r, const poly *a, const poly *b);
 
 #endif
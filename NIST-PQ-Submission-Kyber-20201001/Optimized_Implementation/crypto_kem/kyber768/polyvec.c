@@ -2,11 +2,14 @@
 #include "params.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "swar.h"
 
 /*************************************************
 * Name:        polyvec_compress
 *
-* Description: Compress and serialize vector of polynomials
+* Description: Compress and serialize vector of polynomials;
+*              the conditional subtraction of q is fused into the packing
+*              loop, the input vector is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (needs space for KYBER_POLYVECCOMPRESSEDBYTES)
@@ -15,15 +18,16 @@
 void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
 {
   unsigned int i,j,k;
-
-  polyvec_csubq(a);
+  int16_t u[8];
 
 #if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
   uint16_t t[8];
   for(i=0;i<KYBER_K;i++) {
     for(j=0;j<KYBER_N/8;j++) {
+      swar_store(u,   swar_csubq(swar_load(&a->vec[i].coeffs[8*j])));
+      swar_store(u+4, swar_csubq(swar_load(&a->vec[i].coeffs[8*j+4])));
       for(k=0;k<8;k++)
-        t[k] = ((((uint32_t)a->vec[i].coeffs[8*j+k] << 11) + KYBER_Q/2)
+        t[k] = ((((uint32_t)(uint16_t)u[k] << 11) + KYBER_Q/2)
                 /KYBER_Q) & 0x7ff;
 
       r[ 0] = (t[0] >>  0);
@@ -44,8 +48,9 @@ void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
   uint16_t t[4];
   for(i=0;i<KYBER_K;i++) {
     for(j=0;j<KYBER_N/4;j++) {
+      swar_store(u, swar_csubq(swar_load(&a->vec[i].coeffs[4*j])));
       for(k=0;k<4;k++)
-        t[k] = ((((uint32_t)a->vec[i].coeffs[4*j+k] << 10) + KYBER_Q/2)
+        t[k] = ((((uint32_t)(uint16_t)u[k] << 10) + KYBER_Q/2)
                 / KYBER_Q) & 0x3ff;
 
       r[0] = (t[0] >> 0);
@@ -176,18 +181,21 @@ void polyvec_invntt_tomont(polyvec *r)
 }
 
 /*************************************************
-* Name:        polyvec_pointwise_acc_montgomery
+* Name:        polyvec_pointwise_acc_montgomery_lazy
 *
 * Description: Pointwise multiply elements of a and b, accumulate into r,
-*              and multiply by 2^-16.
+*              and multiply by 2^-16, without the final Barrett reduction.
+*              Every basemul output coefficient is bounded by 2q in absolute
+*              value, so the coefficients of r are bounded by 2*KYBER_K*q
+*              < 2^15. For callers that reduce anyway, e.g. via poly_tomont.
 *
 * Arguments: - poly *r:          pointer to output polynomial
 *            - const polyvec *a: pointer to first input vector of polynomials
 *            - const polyvec *b: pointer to second input vector of polynomials
 **************************************************/
-void polyvec_pointwise_acc_montgomery(poly *r,
-                                      const polyvec *a,
-                                      const polyvec *b)
+void polyvec_pointwise_acc_montgomery_lazy(poly *r,
+                                           const polyvec *a,
+                                           const polyvec *b)
 {
   unsigned int i;
   poly t;
@@ -197,7 +205,23 @@ void polyvec_pointwise_acc_montgomery(poly *r,
     poly_basemul_montgomery(&t, &a->vec[i], &b->vec[i]);
     poly_add(r, r, &t);
   }
+}
 
+/*************************************************
+* Name:        polyvec_pointwise_acc_montgomery
+*
+* Description: Pointwise multiply elements of a and b, accumulate into r,
+*              and multiply by 2^-16.
+*
+* Arguments: - poly *r:          pointer to output polynomial
+*            - const polyvec *a: pointer to first input vector of polynomials
+*            - const polyvec *b: pointer to second input vector of polynomials
+**************************************************/
+void polyvec_pointwise_acc_montgomery(poly *r,
+                                      const polyvec *a,
+                                      const polyvec *b)
+{
+  polyvec_pointwise_acc_montgomery_lazy(r, a, b);
   poly_reduce(r);
 }
 
@@ -249,3 +273,20 @@ void polyvec_add(polyvec *r, const polyvec *a, const polyvec *b)
   for(i=0;i<KYBER_K;i++)
     poly_add(&r->vec[i], &a->vec[i], &b->vec[i]);
 }
+
+/*************************************************
+* Name:        polyvec_add_reduce
+*
+* Description: Add vectors of polynomials and apply Barrett reduction to
+*              the sum in the same pass
+*
+* Arguments: - polyvec *r:       pointer to output vector of polynomials
+*            - const polyvec *a: pointer to first input vector of polynomials
+*            - const polyvec *b: pointer to second input vector of polynomials
+**************************************************/
+void polyvec_add_reduce(polyvec *r, const polyvec *a, const polyvec *b)
+{
+  unsigned int i;
+  for(i=0;i<KYBER_K;i++)
+    poly_add_reduce(&r->vec[i], &a->vec[i], &b->vec[i]);
+}
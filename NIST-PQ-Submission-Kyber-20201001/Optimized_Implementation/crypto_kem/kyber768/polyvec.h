@@ -25,6 +25,11 @@ void polyvec_ntt(polyvec *r);
 #define polyvec_invntt_tomont KYBER_NAMESPACE(_polyvec_invntt_tomont)
 void polyvec_invntt_tomont(polyvec *r);
 
+#define polyvec_pointwise_acc_montgomery_lazy \
+        KYBER_NAMESPACE(_polyvec_pointwise_acc_montgomery_lazy)
+void polyvec_pointwise_acc_montgomery_lazy(poly *r,
+                                           const polyvec *a,
+                                           const polyvec *b);
 #define polyvec_pointwise_acc_montgomery \
         KYBER_NAMESPACE(_polyvec_pointwise_acc_montgomery)
 void polyvec_pointwise_acc_montgomery(poly *r,
@@ -38,5 +43,7 @@ void polyvec_csubq(polyvec *r);
 
 #define polyvec_add KYBER_NAMESPACE(_polyvec_add)
 void polyvec_add(polyvec *r, const polyvec *a, const polyvec *b);
+#define polyvec_add_reduce KYBER_NAMESPACE(_polyvec_add_reduce)
+void polyvec_add_reduce(polyvec *r, const polyvec *a, const polyvec *b);
 
 #endif
@@ -0,0 +1,150 @@
+#ifndef SWAR_H
+#define SWAR_H
+
+#include <stdint.h>
+#include <string.h>
+#include "params.h"
+#include "reduce.h"
+
+/*
+ * SIMD within a register: four int16_t coefficients are packed into one
+ * uint64_t, coefficient 0 in the least significant lane. Additions and
+ * subtractions handle the top bit of every lane separately so that carries
+ * and borrows never cross lane boundaries; multiplications are done on the
+ * even and odd lanes separately, widened to 32 bits.
+ */
+#define SWAR_ONES  0x0001000100010001ULL  /* 1 in every 16-bit lane */
+#define SWAR_HIGH  0x8000800080008000ULL  /* top bit of every 16-bit lane */
+#define SWAR_EVEN  0x0000FFFF0000FFFFULL  /* lanes 0 and 2 as 32-bit lanes */
+
+/*************************************************
+* Name:        swar_load
+*
+* Description: Pack 4 coefficients into a 64-bit word
+*
+* Arguments:   - const int16_t *a: pointer to 4 input coefficients
+*
+* Returns the packed word
+**************************************************/
+static inline uint64_t swar_load(const int16_t a[4])
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  uint64_t r;
+  memcpy(&r, a, sizeof(r));
+  return r;
+#else
+  return (uint64_t)(uint16_t)a[0]
+       | (uint64_t)(uint16_t)a[1] << 16
+       | (uint64_t)(uint16_t)a[2] << 32
+       | (uint64_t)(uint16_t)a[3] << 48;
+#endif
+}
+
+/*************************************************
+* Name:        swar_store
+*
+* Description: Unpack a 64-bit word into 4 coefficients
+*
+* Arguments:   - int16_t *r: pointer to 4 output coefficients
+*              - uint64_t a: packed input word
+**************************************************/
+static inline void swar_store(int16_t r[4], uint64_t a)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  memcpy(r, &a, sizeof(a));
+#else
+  r[0] = (int16_t)(a >>  0);
+  r[1] = (int16_t)(a >> 16);
+  r[2] = (int16_t)(a >> 32);
+  r[3] = (int16_t)(a >> 48);
+#endif
+}
+
+/*************************************************
+* Name:        swar_add
+*
+* Description: Lane-wise addition modulo 2^16
+**************************************************/
+static inline uint64_t swar_add(uint64_t a, uint64_t b)
+{
+  return ((a & ~SWAR_HIGH) + (b & ~SWAR_HIGH)) ^ ((a ^ b) & SWAR_HIGH);
+}
+
+/*************************************************
+* Name:        swar_sub
+*
+* Description: Lane-wise subtraction modulo 2^16
+**************************************************/
+static inline uint64_t swar_sub(uint64_t a, uint64_t b)
+{
+  return ((a | SWAR_HIGH) - (b & ~SWAR_HIGH)) ^ ((a ^ ~b) & SWAR_HIGH);
+}
+
+/*************************************************
+* Name:        swar_csubq
+*
+* Description: Lane-wise conditional subtraction of q; same output as csubq
+**************************************************/
+static inline uint64_t swar_csubq(uint64_t a)
+{
+  uint64_t m;
+
+  a = swar_sub(a, KYBER_Q*SWAR_ONES);
+  m = ((a & SWAR_HIGH) >> 15) * 0xFFFF;
+  return swar_add(a, m & (KYBER_Q*SWAR_ONES));
+}
+
+/*************************************************
+* Name:        swar_barrett_reduce
+*
+* Description: Lane-wise Barrett reduction; same output as barrett_reduce.
+*              With a' = a + 2^15 in [0,2^16) and v = 20159 the quotient is
+*              floor(v*a/2^26) = floor((v*a' + d)/2^26) - 10 for the bias
+*              d = 10*2^26 - v*2^15. Both v*a' + d < 2^31 and the quotient
+*              times q fit into 32-bit lanes without crossing lanes.
+**************************************************/
+static inline uint64_t swar_barrett_reduce(uint64_t a)
+{
+  const uint64_t v = ((1U << 26) + KYBER_Q/2)/KYBER_Q;
+  const uint64_t d = (10ULL << 26) - (v << 15);
+  uint64_t b, e, o;
+
+  b = a ^ SWAR_HIGH;
+  e = ( b        & SWAR_EVEN)*v + (d | d << 32);
+  o = ((b >> 16) & SWAR_EVEN)*v + (d | d << 32);
+  e = ((e >> 26) & 0x0000003F0000003FULL)*KYBER_Q;
+  o = ((o >> 26) & 0x0000003F0000003FULL)*KYBER_Q;
+
+  /* a - (t-10)*q = a + 10*q - t*q */
+  a = swar_add(a, 10*KYBER_Q*SWAR_ONES);
+  return swar_sub(a, (e & SWAR_EVEN) | (o & SWAR_EVEN) << 16);
+}
+
+/*************************************************
+* Name:        swar_tomont
+*
+* Description: Lane-wise montgomery_reduce(a*f) for f = 2^32 mod q;
+*              same output as poly_tomont on each coefficient.
+*              With u = a*f*q^-1 mod 2^16 and the unsigned representatives
+*              a' = a + 2^15, u' = u + 2^15 of a and u, the numerator of the
+*              reduction is a*f - u*q = a'*f - u'*q + 2^15*(q-f). Adding 2^28
+*              keeps it in [0,2^32) in every 32-bit lane.
+**************************************************/
+static inline uint64_t swar_tomont(uint64_t a)
+{
+  const uint64_t f = (1ULL << 32) % KYBER_Q;
+  const uint64_t c = (f*QINV) & 0xFFFF;
+  const uint64_t k = (1ULL << 28) + ((KYBER_Q - f) << 15);
+  uint64_t b, ue, uo, e, o;
+
+  b  = a ^ SWAR_HIGH;
+  ue = ((( a        & SWAR_EVEN)*c) & SWAR_EVEN) ^ (SWAR_HIGH & SWAR_EVEN);
+  uo = ((((a >> 16) & SWAR_EVEN)*c) & SWAR_EVEN) ^ (SWAR_HIGH & SWAR_EVEN);
+  e  = ( b        & SWAR_EVEN)*f + (k | k << 32) - ue*KYBER_Q;
+  o  = ((b >> 16) & SWAR_EVEN)*f + (k | k << 32) - uo*KYBER_Q;
+
+  a = ((e >> 16) & SWAR_EVEN) | ((o >> 16) & SWAR_EVEN) << 16;
+  return swar_sub(a, (1 << 12)*SWAR_ONES);
+}
+
+#endif
@@ -3,7 +3,6 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "api.h"
-#include "kex.h"
 #include "params.h"
 #include "indcpa.h"
 #include "poly.h"
@@ -23,9 +22,6 @@ int main()
   unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
   unsigned char ct[CRYPTO_CIPHERTEXTBYTES] = {0};
   unsigned char key[CRYPTO_BYTES] = {0};
-  unsigned char kexsenda[KEX_AKE_SENDABYTES] = {0};
-  unsigned char kexsendb[KEX_AKE_SENDBBYTES] = {0};
-  unsigned char kexkey[KEX_SSBYTES] = {0};
   polyvec matrix[KYBER_K];
   poly ap;
 
@@ -77,41 +73,5 @@ int main()
   }
   print_results("kyber_decaps: ", t, NTESTS);
 
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_uake_initA(kexsenda, key, sk, pk);
-  }
-  print_results("kex_uake_initA: ", t, NTESTS);
-
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_uake_sharedB(kexsendb, kexkey, kexsenda, sk);
-  }
-  print_results("kex_uake_sharedB: ", t, NTESTS);
-
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_uake_sharedA(kexkey, kexsendb, key, sk);
-  }
-  print_results("kex_uake_sharedA: ", t, NTESTS);
-
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_ake_initA(kexsenda, key, sk, pk);
-  }
-  print_results("kex_ake_initA: ", t, NTESTS);
-
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_ake_sharedB(kexsendb, kexkey, kexsenda, sk, pk);
-  }
-  print_results("kex_ake_sharedB: ", t, NTESTS);
-
-  for(i=0;i<NTESTS;i++) {
-    t[i] = cpucycles();
-    kex_ake_sharedA(kexkey, kexsendb, key, sk, sk);
-  }
-  print_results("kex_ake_sharedA: ", t, NTESTS);
-
   return 0;
 }
@@ -1,25 +1,42 @@
 #include <stdint.h>
+#include <string.h>
 #include "params.h"
 #include "cbd.h"
+#include "opcount.h"
+
+/*
+ * The samplers work on wide words: the bit counts of all coefficients
+ * of a 64-bit word are added in parallel, the differences a - b are
+ * formed per field, offset by eta so that no borrow crosses fields, and
+ * groups of four fields are spread into the 16-bit lanes of a 64-bit
+ * word, from which eta is subtracted lane-wise.
+ */
+#define CBD_ONES 0x0001000100010001ULL  /* 1 in every 16-bit lane */
+#define CBD_HIGH 0x8000800080008000ULL  /* top bit of every 16-bit lane */
 
 /*************************************************
-* Name:        load32_littleendian
+* Name:        load64_littleendian
 *
-* Description: load 4 bytes into a 32-bit integer
+* Description: load 8 bytes into a 64-bit integer
 *              in little-endian order
 *
 * Arguments:   - const uint8_t *x: pointer to input byte array
 *
-* Returns 32-bit unsigned integer loaded from x
+* Returns 64-bit unsigned integer loaded from x
 **************************************************/
-static uint32_t load32_littleendian(const uint8_t x[4])
+static uint64_t load64_littleendian(const uint8_t x[8])
 {
-  uint32_t r;
-  r  = (uint32_t)x[0];
-  r |= (uint32_t)x[1] << 8;
-  r |= (uint32_t)x[2] << 16;
-  r |= (uint32_t)x[3] << 24;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  uint64_t r;
+  memcpy(&r, x, sizeof(r));
+  return r;
+#else
+  unsigned int i;
+  uint64_t r = 0;
+  for(i=0;i<8;i++)
+    r |= (uint64_t)x[i] << 8*i;
   return r;
+#endif
 }
 
 /*************************************************
@@ -44,6 +61,66 @@ static uint32_t load24_littleendian(const uint8_t x[3])
 }
 #endif
 
+/*************************************************
+* Name:        cbd_store4
+*
+* Description: Spread four w-bit fields holding a - b + eta into the
+*              16-bit lanes of a 64-bit word, subtract eta lane-wise and
+*              store the four coefficients. The subtraction is done with
+*              the top bit of every lane set, so no borrow crosses lanes.
+*
+* Arguments:   - int16_t *r:       pointer to 4 output coefficients
+*              - uint64_t y:       fields in the lowest 4*w bits
+*              - unsigned int w:   field width in bits
+*              - unsigned int eta: offset of the fields
+**************************************************/
+static inline void cbd_store4(int16_t r[4],
+                              uint64_t y,
+                              unsigned int w,
+                              unsigned int eta)
+{
+  const uint64_t m = (1ULL << w) - 1;
+  uint64_t z;
+
+  z  =  y & m;
+  z |= (y & m << 1*w) << (16 - 1*w);
+  z |= (y & m << 2*w) << (32 - 2*w);
+  z |= (y & m << 3*w) << (48 - 3*w);
+  z  = ((z | CBD_HIGH) - eta*CBD_ONES) ^ CBD_HIGH;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  memcpy(r, &z, sizeof(z));
+#else
+  r[0] = (int16_t)(z >>  0);
+  r[1] = (int16_t)(z >> 16);
+  r[2] = (int16_t)(z >> 32);
+  r[3] = (int16_t)(z >> 48);
+#endif
+}
+
+/*************************************************
+* Name:        cbd2_word
+*
+* Description: Centered binomial distribution with parameter eta=2 on
+*              64 uniformly random bits, giving 16 coefficients
+*
+* Arguments:   - int16_t *r: pointer to 16 output coefficients
+*              - uint64_t t: input bits
+**************************************************/
+static void cbd2_word(int16_t r[16], uint64_t t)
+{
+  unsigned int j;
+  uint64_t d;
+
+  d  = t & 0x5555555555555555ULL;
+  d += (t>>1) & 0x5555555555555555ULL;
+  /* every nibble now holds a - b + 2 in {0,...,4} */
+  d  = (d & 0x3333333333333333ULL) + 0x2222222222222222ULL
+     - ((d >> 2) & 0x3333333333333333ULL);
+
+  for(j=0;j<4;j++)
+    cbd_store4(r+4*j, d >> 16*j, 4, 2);
+}
 
 /*************************************************
 * Name:        cbd2
@@ -57,21 +134,9 @@ static uint32_t load24_littleendian(const uint8_t x[3])
 **************************************************/
 static void cbd2(poly *r, const uint8_t buf[2*KYBER_N/4])
 {
-  unsigned int i,j;
-  uint32_t t,d;
-  int16_t a,b;
-
-  for(i=0;i<KYBER_N/8;i++) {
-    t  = load32_littleendian(buf+4*i);
-    d  = t & 0x55555555;
-    d += (t>>1) & 0x55555555;
-
-    for(j=0;j<8;j++) {
-      a = (d >> (4*j+0)) & 0x3;
-      b = (d >> (4*j+2)) & 0x3;
-      r->coeffs[8*i+j] = a - b;
-    }
-  }
+  unsigned int i;
+  for(i=0;i<KYBER_N/16;i++)
+    cbd2_word(r->coeffs+16*i, load64_littleendian(buf+8*i));
 }
 
 /*************************************************
@@ -107,6 +172,130 @@ static void cbd3(poly *r, const uint8_t buf[3*KYBER_N/4])
 }
 #endif
 
+#ifndef KYBER_90S
+/*************************************************
+* Name:        cbd2_keccak
+*
+* Description: cbd2 on SHAKE256 output read directly from the Keccak
+*              state; every 64-bit lane gives 16 coefficients
+*
+* Arguments:   - poly *r:              pointer to output polynomial
+*              - keccak_state *state:  pointer to absorbed SHAKE256 state
+**************************************************/
+static void cbd2_keccak(poly *r, keccak_state *state)
+{
+  unsigned int i;
+
+#if 2*KYBER_N/4 > SHAKE256_RATE
+#error "cbd2_keccak assumes that one SHAKE256 block suffices"
+#endif
+
+  OPCOUNT_ADD(keccak_shake256, 1);
+  keccak_permute(state);
+  for(i=0;i<KYBER_N/16;i++)
+    cbd2_word(r->coeffs+16*i, state->s[i]);
+}
+
+#if KYBER_ETA1 == 3
+/*************************************************
+* Name:        cbd3_word
+*
+* Description: Centered binomial distribution with parameter eta=3 on
+*              48 uniformly random bits, giving 8 coefficients
+*              This function is only needed for Kyber-512
+*
+* Arguments:   - int16_t *r: pointer to 8 output coefficients
+*              - uint64_t t: input bits in the lowest 48 bits
+**************************************************/
+static void cbd3_word(int16_t r[8], uint64_t t)
+{
+  uint64_t d;
+
+  d  = t & 0x249249249249ULL;
+  d += (t>>1) & 0x249249249249ULL;
+  d += (t>>2) & 0x249249249249ULL;
+  /* every 6-bit field now holds a - b + 3 in {0,...,6} */
+  d  = (d & 0x1C71C71C71C7ULL) + 0x0C30C30C30C3ULL
+     - ((d >> 3) & 0x1C71C71C71C7ULL);
+
+  cbd_store4(r,   d,       6, 3);
+  cbd_store4(r+4, d >> 24, 6, 3);
+}
+
+/*************************************************
+* Name:        cbd3_words
+*
+* Description: cbd3 on 192 bits given as three 64-bit words,
+*              split into four 48-bit words of 8 coefficients each
+*
+* Arguments:   - int16_t *r:  pointer to 32 output coefficients
+*              - uint64_t t0, t1, t2: input words, t0 least significant
+**************************************************/
+static void cbd3_words(int16_t r[32], uint64_t t0, uint64_t t1, uint64_t t2)
+{
+  const uint64_t m = 0xFFFFFFFFFFFFULL;
+
+  cbd3_word(r,    t0 & m);
+  cbd3_word(r+8,  (t0 >> 48 | t1 << 16) & m);
+  cbd3_word(r+16, (t1 >> 32 | t2 << 32) & m);
+  cbd3_word(r+24, t2 >> 16);
+}
+
+/*************************************************
+* Name:        cbd3_keccak
+*
+* Description: cbd3 on SHAKE256 output read directly from the Keccak
+*              state. The 24 lanes span two blocks of 17 lanes; the two
+*              lanes of the group of three that straddles the blocks are
+*              kept across the second permutation.
+*
+* Arguments:   - poly *r:              pointer to output polynomial
+*              - keccak_state *state:  pointer to absorbed SHAKE256 state
+**************************************************/
+static void cbd3_keccak(poly *r, keccak_state *state)
+{
+  unsigned int i;
+  uint64_t t0,t1;
+
+#if SHAKE256_RATE != 136
+#error "cbd3_keccak assumes the SHAKE256 rate of 17 lanes"
+#endif
+
+  OPCOUNT_ADD(keccak_shake256, 2);
+  keccak_permute(state);
+  for(i=0;i<5;i++)
+    cbd3_words(r->coeffs+32*i, state->s[3*i], state->s[3*i+1], state->s[3*i+2]);
+  t0 = state->s[15];
+  t1 = state->s[16];
+
+  keccak_permute(state);
+  cbd3_words(r->coeffs+160, t0, t1, state->s[0]);
+  cbd3_words(r->coeffs+192, state->s[1], state->s[2], state->s[3]);
+  cbd3_words(r->coeffs+224, state->s[4], state->s[5], state->s[6]);
+}
+#endif
+
+void cbd_eta1_keccak(poly *r, keccak_state *state)
+{
+#if KYBER_ETA1 == 2
+  cbd2_keccak(r, state);
+#elif KYBER_ETA1 == 3
+  cbd3_keccak(r, state);
+#else
+#error "This implementation requires eta1 in {2,3}"
+#endif
+}
+
+void cbd_eta2_keccak(poly *r, keccak_state *state)
+{
+#if KYBER_ETA2 != 2
+#error "This implementation requires eta2 = 2"
+#else
+  cbd2_keccak(r, state);
+#endif
+}
+#endif
+
 void cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4])
 {
 #if KYBER_ETA1 == 2
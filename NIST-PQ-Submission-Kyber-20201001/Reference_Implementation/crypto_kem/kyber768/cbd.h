@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include "params.h"
 #include "poly.h"
+#ifndef KYBER_90S
+#include "fips202.h"
+#endif
 
 #define cbd_eta1 KYBER_NAMESPACE(_cbd_eta1)
 void cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4]);
@@ -11,4 +14,12 @@ void cbd_eta1(poly *r, const uint8_t buf[KYBER_ETA1*KYBER_N/4]);
 #define cbd_eta2 KYBER_NAMESPACE(_cbd_eta2)
 void cbd_eta2(poly *r, const uint8_t buf[KYBER_ETA2*KYBER_N/4]);
 
+#ifndef KYBER_90S
+#define cbd_eta1_keccak KYBER_NAMESPACE(_cbd_eta1_keccak)
+void cbd_eta1_keccak(poly *r, keccak_state *state);
+
+#define cbd_eta2_keccak KYBER_NAMESPACE(_cbd_eta2_keccak)
+void cbd_eta2_keccak(poly *r, keccak_state *state);
+#endif
+
 #endif
@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "fips202.h"
+#include "opcount.h"
 
 #define NROUNDS 24
 #define ROL(a, offset) ((a << offset) ^ (a >> (64-offset)))
@@ -98,6 +99,8 @@ static void KeccakF1600_StatePermute(uint64_t state[25])
         uint64_t Ema, Eme, Emi, Emo, Emu;
         uint64_t Esa, Ese, Esi, Eso, Esu;
 
+        OPCOUNT_ADD(keccak, 1);
+
         //copyFromState(A, state)
         Aba = state[ 0];
         Abe = state[ 1];
@@ -429,6 +432,7 @@ static void keccak_squeezeblocks(uint8_t *out,
 **************************************************/
 void shake128_absorb(keccak_state *state, const uint8_t *in, size_t inlen)
 {
+  OPCOUNT_ADD(keccak_shake128, inlen/SHAKE128_RATE);
   keccak_absorb(state->s, SHAKE128_RATE, in, inlen, 0x1F);
 }
 
@@ -446,6 +450,7 @@ void shake128_absorb(keccak_state *state, const uint8_t *in, size_t inlen)
 **************************************************/
 void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state)
 {
+  OPCOUNT_ADD(keccak_shake128, nblocks);
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE128_RATE);
 }
 
@@ -461,6 +466,7 @@ void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state)
 **************************************************/
 void shake256_absorb(keccak_state *state, const uint8_t *in, size_t inlen)
 {
+  OPCOUNT_ADD(keccak_shake256, inlen/SHAKE256_RATE);
   keccak_absorb(state->s, SHAKE256_RATE, in, inlen, 0x1F);
 }
 
@@ -478,9 +484,27 @@ void shake256_absorb(keccak_state *state, const uint8_t *in, size_t inlen)
 **************************************************/
 void shake256_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state)
 {
+  OPCOUNT_ADD(keccak_shake256, nblocks);
   keccak_squeezeblocks(out, nblocks, state->s, SHAKE256_RATE);
 }
 
+/*************************************************
+* Name:        keccak_permute
+*
+* Description: Squeeze one block in place. After the permutation the
+*              first rate/8 lanes of the state are the next output block:
+*              lane i holds output bytes 8*i,...,8*i+7 as a little-endian
+*              64-bit integer. Lets samplers consume the output directly
+*              from the state instead of from a squeezed byte array.
+*
+* Arguments:   - keccak_state *state: pointer to input/output Keccak state
+**************************************************/
+void keccak_permute(keccak_state *state)
+{
+  /* counted by rate at the callers */
+  KeccakF1600_StatePermute(state->s);
+}
+
 /*************************************************
 * Name:        shake128
 *
@@ -556,6 +580,7 @@ void sha3_256(uint8_t h[32], const uint8_t *in, size_t inlen)
   uint64_t s[25];
   uint8_t t[SHA3_256_RATE];
 
+  OPCOUNT_ADD(keccak_sha3, inlen/SHA3_256_RATE + 1);
   keccak_absorb(s, SHA3_256_RATE, in, inlen, 0x06);
   keccak_squeezeblocks(t, 1, s, SHA3_256_RATE);
 
@@ -578,9 +603,175 @@ void sha3_512(uint8_t *h, const uint8_t *in, size_t inlen)
   uint64_t s[25];
   uint8_t t[SHA3_512_RATE];
 
+  OPCOUNT_ADD(keccak_sha3, inlen/SHA3_512_RATE + 1);
   keccak_absorb(s, SHA3_512_RATE, in, inlen, 0x06);
   keccak_squeezeblocks(t, 1, s, SHA3_512_RATE);
 
   for(i=0;i<64;i++)
     h[i] = t[i];
 }
+
+/*************************************************
+* Name:        keccak_absorb_once
+*
+* Description: Absorb step of Keccak for inputs shorter than the rate.
+*              The input and the padding are written straight into the
+*              state lanes; there is no padded copy of the block and no
+*              block loop. Inlined with constant r and inlen by the
+*              fixed-shape functions below.
+*
+* Arguments:   - uint64_t *s: pointer to (uninitialized) output Keccak state
+*              - unsigned int r: rate in bytes
+*              - const uint8_t *in: pointer to input
+*              - size_t inlen: length of input in bytes, smaller than r
+*              - uint8_t p: domain-separation byte
+**************************************************/
+static inline void keccak_absorb_once(uint64_t s[25],
+                                      unsigned int r,
+                                      const uint8_t *in,
+                                      size_t inlen,
+                                      uint8_t p)
+{
+  unsigned int i;
+
+  for(i=0;i<25;i++)
+    s[i] = 0;
+  for(i=0;i<inlen/8;i++)
+    s[i] = load64(in + 8*i);
+  for(i=0;i<inlen%8;i++)
+    s[inlen/8] |= (uint64_t)in[inlen - inlen%8 + i] << 8*i;
+
+  s[inlen/8] ^= (uint64_t)p << 8*(inlen%8);
+  s[r/8-1] ^= 1ULL << 63;
+}
+
+/*************************************************
+* Name:        keccak_extract
+*
+* Description: Store the first outlen bytes of the state lanes, i.e. of
+*              the current output block
+*
+* Arguments:   - uint8_t *out: pointer to output
+*              - size_t outlen: number of bytes, a multiple of 8
+*              - const uint64_t *s: pointer to Keccak state
+**************************************************/
+static inline void keccak_extract(uint8_t *out,
+                                  size_t outlen,
+                                  const uint64_t s[25])
+{
+  unsigned int i;
+  for(i=0;i<outlen/8;i++)
+    store64(out + 8*i, s[i]);
+}
+
+/*************************************************
+* Name:        shake128_absorb_34
+*
+* Description: shake128_absorb for 34-byte inputs (seed and two indices)
+**************************************************/
+void shake128_absorb_34(keccak_state *state, const uint8_t in[34])
+{
+  keccak_absorb_once(state->s, SHAKE128_RATE, in, 34, 0x1F);
+}
+
+/*************************************************
+* Name:        shake256_absorb_33
+*
+* Description: shake256_absorb for 33-byte inputs (key and nonce)
+**************************************************/
+void shake256_absorb_33(keccak_state *state, const uint8_t in[33])
+{
+  keccak_absorb_once(state->s, SHAKE256_RATE, in, 33, 0x1F);
+}
+
+/*************************************************
+* Name:        shake256_33_128
+*
+* Description: shake256 with 33 bytes of input and 128 bytes of output
+**************************************************/
+void shake256_33_128(uint8_t out[128], const uint8_t in[33])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_shake256, 1);
+  keccak_absorb_once(s, SHAKE256_RATE, in, 33, 0x1F);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(out, 128, s);
+}
+
+/*************************************************
+* Name:        shake256_33_192
+*
+* Description: shake256 with 33 bytes of input and 192 bytes of output
+**************************************************/
+void shake256_33_192(uint8_t out[192], const uint8_t in[33])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_shake256, 2);
+  keccak_absorb_once(s, SHAKE256_RATE, in, 33, 0x1F);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(out, SHAKE256_RATE, s);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(out + SHAKE256_RATE, 192 - SHAKE256_RATE, s);
+}
+
+/*************************************************
+* Name:        shake256_64_32
+*
+* Description: shake256 with 64 bytes of input and 32 bytes of output
+**************************************************/
+void shake256_64_32(uint8_t out[32], const uint8_t in[64])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_shake256, 1);
+  keccak_absorb_once(s, SHAKE256_RATE, in, 64, 0x1F);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(out, 32, s);
+}
+
+/*************************************************
+* Name:        sha3_256_32
+*
+* Description: sha3_256 for 32-byte inputs
+**************************************************/
+void sha3_256_32(uint8_t h[32], const uint8_t in[32])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_sha3, 1);
+  keccak_absorb_once(s, SHA3_256_RATE, in, 32, 0x06);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(h, 32, s);
+}
+
+/*************************************************
+* Name:        sha3_512_32
+*
+* Description: sha3_512 for 32-byte inputs
+**************************************************/
+void sha3_512_32(uint8_t h[64], const uint8_t in[32])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_sha3, 1);
+  keccak_absorb_once(s, SHA3_512_RATE, in, 32, 0x06);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(h, 64, s);
+}
+
+/*************************************************
+* Name:        sha3_512_64
+*
+* Description: sha3_512 for 64-byte inputs
+**************************************************/
+void sha3_512_64(uint8_t h[64], const uint8_t in[64])
+{
+  uint64_t s[25];
+
+  OPCOUNT_ADD(keccak_sha3, 1);
+  keccak_absorb_once(s, SHA3_512_RATE, in, 64, 0x06);
+  KeccakF1600_StatePermute(s);
+  keccak_extract(h, 64, s);
+}
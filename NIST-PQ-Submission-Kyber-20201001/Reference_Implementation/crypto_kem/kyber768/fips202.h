@@ -24,6 +24,8 @@ void shake128_squeezeblocks(uint8_t *out, size_t nblocks, keccak_state *state);
 void shake256_absorb(keccak_state *state, const uint8_t *in, size_t inlen);
 #define shake256_squeezeblocks FIPS202_NAMESPACE(_shake256_squeezeblocks)
 void shake256_squeezeblocks(uint8_t *out, size_t nblocks,  keccak_state *state);
+#define keccak_permute FIPS202_NAMESPACE(_keccak_permute)
+void keccak_permute(keccak_state *state);
 #define shake128 FIPS202_NAMESPACE(_shake128)
 void shake128(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen);
 #define shake256 FIPS202_NAMESPACE(_shake256)
@@ -33,4 +35,22 @@ void sha3_256(uint8_t h[32], const uint8_t *in, size_t inlen);
 #define sha3_512 FIPS202_NAMESPACE(_sha3_512)
 void sha3_512(uint8_t h[64], const uint8_t *in, size_t inlen);
 
+/* Fixed-shape variants for the input and output lengths used by Kyber */
+#define shake128_absorb_34 FIPS202_NAMESPACE(_shake128_absorb_34)
+void shake128_absorb_34(keccak_state *state, const uint8_t in[34]);
+#define shake256_absorb_33 FIPS202_NAMESPACE(_shake256_absorb_33)
+void shake256_absorb_33(keccak_state *state, const uint8_t in[33]);
+#define shake256_33_128 FIPS202_NAMESPACE(_shake256_33_128)
+void shake256_33_128(uint8_t out[128], const uint8_t in[33]);
+#define shake256_33_192 FIPS202_NAMESPACE(_shake256_33_192)
+void shake256_33_192(uint8_t out[192], const uint8_t in[33]);
+#define shake256_64_32 FIPS202_NAMESPACE(_shake256_64_32)
+void shake256_64_32(uint8_t out[32], const uint8_t in[64]);
+#define sha3_256_32 FIPS202_NAMESPACE(_sha3_256_32)
+void sha3_256_32(uint8_t h[32], const uint8_t in[32]);
+#define sha3_512_32 FIPS202_NAMESPACE(_sha3_512_32)
+void sha3_512_32(uint8_t h[64], const uint8_t in[32]);
+#define sha3_512_64 FIPS202_NAMESPACE(_sha3_512_64)
+void sha3_512_64(uint8_t h[64], const uint8_t in[64]);
+
 #endif
@@ -7,6 +7,8 @@
 #include "rng.h"
 #include "ntt.h"
 #include "symmetric.h"
+#include "trace.h"
+#include "opcount.h"
 
 /*************************************************
 * Name:        pack_pk
@@ -80,43 +82,7 @@ static void unpack_sk(polyvec *sk,
   polyvec_frombytes(sk, packedsk);
 }
 
-/*************************************************
-* Name:        pack_ciphertext
-*
-* Description: Serialize the ciphertext as concatenation of the
-*              compressed and serialized vector of polynomials b
-*              and the compressed and serialized polynomial v
-*
-* Arguments:   uint8_t *r: pointer to the output serialized ciphertext
-*              poly *pk:   pointer to the input vector of polynomials b
-*              poly *v:    pointer to the input polynomial v
-**************************************************/
-static void pack_ciphertext(uint8_t r[KYBER_INDCPA_BYTES],
-                            polyvec *b,
-                            poly *v)
-{
-  polyvec_compress(r, b);
-  poly_compress(r+KYBER_POLYVECCOMPRESSEDBYTES, v);
-}
-
-/*************************************************
-* Name:        unpack_ciphertext
-*
-* Description: De-serialize and decompress ciphertext from a byte array;
-*              approximate inverse of pack_ciphertext
-*
-* Arguments:   - polyvec *b:       pointer to the output vector of polynomials b
-*              - poly *v:          pointer to the output polynomial v
-*              - const uint8_t *c: pointer to the input serialized ciphertext
-**************************************************/
-static void unpack_ciphertext(polyvec *b,
-                              poly *v,
-                              const uint8_t c[KYBER_INDCPA_BYTES])
-{
-  polyvec_decompress(b, c);
-  poly_decompress(v, c+KYBER_POLYVECCOMPRESSEDBYTES);
-}
-
+#ifdef KYBER_90S
 /*************************************************
 * Name:        rej_uniform
 *
@@ -130,6 +96,9 @@ static void unpack_ciphertext(polyvec *b,
 *                                     (assumed to be uniform random bytes)
 *              - unsigned int buflen: length of input buffer in bytes
 *
+*              Compacts without branches like rej_uniform_keccak while at
+*              least two outputs are missing.
+*
 * Returns number of sampled 16-bit integers (at most len)
 **************************************************/
 static unsigned int rej_uniform(int16_t *r,
@@ -146,17 +115,102 @@ static unsigned int rej_uniform(int16_t *r,
     val1 = ((buf[pos+1] >> 4) | ((uint16_t)buf[pos+2] << 4)) & 0xFFF;
     pos += 3;
 
-    if(val0 < KYBER_Q)
-      r[ctr++] = val0;
-    if(ctr < len && val1 < KYBER_Q)
-      r[ctr++] = val1;
+    if(len - ctr >= 2) {
+      OPCOUNT_ADD(rej_candidates, 2);
+      OPCOUNT_ADD(rej_rejected, (val0 >= KYBER_Q) + (val1 >= KYBER_Q));
+      r[ctr] = val0;
+      ctr += (val0 < KYBER_Q);
+      r[ctr] = val1;
+      ctr += (val1 < KYBER_Q);
+    }
+    else {
+      OPCOUNT_ADD(rej_candidates, 1);
+      OPCOUNT_ADD(rej_rejected, val0 >= KYBER_Q);
+      if(val0 < KYBER_Q)
+        r[ctr++] = val0;
+      if(ctr < len) {
+        OPCOUNT_ADD(rej_candidates, 1);
+        OPCOUNT_ADD(rej_rejected, val1 >= KYBER_Q);
+      }
+      if(ctr < len && val1 < KYBER_Q)
+        r[ctr++] = val1;
+    }
   }
 
   return ctr;
 }
+#else
+/*************************************************
+* Name:        rej_uniform_keccak
+*
+* Description: rej_uniform on one SHAKE128 output block read directly
+*              from the lanes of the Keccak state. The 21 lanes of the
+*              rate form 7 groups of 3 lanes with 16 candidates each, so
+*              no candidate straddles two blocks.
+*              While at least 16 outputs are missing, candidates are
+*              compacted without branches: every candidate is stored at
+*              position ctr and ctr advances by the result of the
+*              comparison with q, a running prefix sum of the accept mask.
+*              Only the last group is sampled with branches.
+*
+* Arguments:   - int16_t *r:          pointer to output buffer
+*              - unsigned int len:    requested number of 16-bit integers
+*                                     (uniform mod q)
+*              - const keccak_state *state: pointer to Keccak state right
+*                                     after a permutation
+*
+* Returns number of sampled 16-bit integers (at most len)
+**************************************************/
+static unsigned int rej_uniform_keccak(int16_t *r,
+                                       unsigned int len,
+                                       const keccak_state *state)
+{
+  unsigned int ctr, i, j;
+  uint64_t t0, t1, t2;
+  uint16_t val[16];
+
+#if SHAKE128_RATE % 24 != 0
+#error "rej_uniform_keccak assumes a rate of a multiple of 3 lanes"
+#endif
+
+  ctr = 0;
+  for(i=0;i<SHAKE128_RATE/24 && ctr < len;i++) {
+    t0 = state->s[3*i+0];
+    t1 = state->s[3*i+1];
+    t2 = state->s[3*i+2];
+
+    for(j=0;j<5;j++)
+      val[j] = (t0 >> 12*j) & 0xFFF;
+    val[5] = (t0 >> 60 | t1 << 4) & 0xFFF;
+    for(j=0;j<4;j++)
+      val[6+j] = (t1 >> (8+12*j)) & 0xFFF;
+    val[10] = (t1 >> 56 | t2 << 8) & 0xFFF;
+    for(j=0;j<5;j++)
+      val[11+j] = (t2 >> (4+12*j)) & 0xFFF;
+
+    if(len - ctr >= 16) {
+      for(j=0;j<16;j++) {
+        OPCOUNT_ADD(rej_candidates, 1);
+        OPCOUNT_ADD(rej_rejected, val[j] >= KYBER_Q);
+        r[ctr] = val[j];
+        ctr += (val[j] < KYBER_Q);
+      }
+    }
+    else {
+      for(j=0;j<16 && ctr < len;j++) {
+        OPCOUNT_ADD(rej_candidates, 1);
+        OPCOUNT_ADD(rej_rejected, val[j] >= KYBER_Q);
+        if(val[j] < KYBER_Q)
+          r[ctr++] = val[j];
+      }
+    }
+  }
+  return ctr;
+}
+#endif
 
-#define gen_a(A,B)  gen_matrix(A,B,0)
-#define gen_at(A,B) gen_matrix(A,B,1)
+#define gen_a(A,B)  gen_matrix_il(A,B,0)
+#define gen_at(A,B) gen_matrix_il(A,B,1)
 
 /*************************************************
 * Name:        gen_matrix
@@ -173,33 +227,90 @@ static unsigned int rej_uniform(int16_t *r,
 **************************************************/
 #define GEN_MATRIX_NBLOCKS ((12*KYBER_N/8*(1 << 12)/KYBER_Q \
                              + XOF_BLOCKBYTES)/XOF_BLOCKBYTES)
-// Not static for benchmarking
-void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
+static void gen_matrix_entry(poly *r,
+                             const uint8_t seed[KYBER_SYMBYTES],
+                             uint8_t x,
+                             uint8_t y)
 {
-  unsigned int ctr, i, j, k;
+#ifndef KYBER_90S
+  unsigned int ctr, nblocks = 0;
+  xof_state state;
+
+  xof_absorb(&state, seed, x, y);
+
+  // sample from the state after every permutation, no squeeze buffer
+  ctr = 0;
+  while(ctr < KYBER_N) {
+    OPCOUNT_ADD(keccak_shake128, 1);
+    keccak_permute(&state);
+    nblocks++;
+    ctr += rej_uniform_keccak(r->coeffs + ctr, KYBER_N - ctr, &state);
+  }
+  OPCOUNT_XOF_ENTRY(nblocks, GEN_MATRIX_NBLOCKS);
+#else
+  unsigned int ctr, k, nblocks = GEN_MATRIX_NBLOCKS;
   unsigned int buflen, off;
   uint8_t buf[GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES+2];
   xof_state state;
 
+  xof_absorb(&state, seed, x, y);
+
+  xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
+  buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
+  ctr = rej_uniform(r->coeffs, KYBER_N, buf, buflen);
+
+  while(ctr < KYBER_N) {
+    off = buflen % 3;
+    for(k = 0; k < off; k++)
+      buf[k] = buf[buflen - off + k];
+    xof_squeezeblocks(buf + off, 1, &state);
+    nblocks++;
+    buflen = off + XOF_BLOCKBYTES;
+    ctr += rej_uniform(r->coeffs + ctr, KYBER_N - ctr, buf, buflen);
+  }
+  OPCOUNT_XOF_ENTRY(nblocks, GEN_MATRIX_NBLOCKS);
+#endif
+}
+
+// Not static for benchmarking
+void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
+{
+  unsigned int i, j;
+
   for(i=0;i<KYBER_K;i++) {
     for(j=0;j<KYBER_K;j++) {
       if(transposed)
-        xof_absorb(&state, seed, i, j);
+        gen_matrix_entry(&a[i].vec[j], seed, i, j);
       else
-        xof_absorb(&state, seed, j, i);
-
-      xof_squeezeblocks(buf, GEN_MATRIX_NBLOCKS, &state);
-      buflen = GEN_MATRIX_NBLOCKS*XOF_BLOCKBYTES;
-      ctr = rej_uniform(a[i].vec[j].coeffs, KYBER_N, buf, buflen);
-
-      while(ctr < KYBER_N) {
-        off = buflen % 3;
-        for(k = 0; k < off; k++)
-          buf[k] = buf[buflen - off + k];
-        xof_squeezeblocks(buf + off, 1, &state);
-        buflen = off + XOF_BLOCKBYTES;
-        ctr += rej_uniform(a[i].vec[j].coeffs + ctr, KYBER_N - ctr, buf, buflen);
-      }
+        gen_matrix_entry(&a[i].vec[j], seed, j, i);
+    }
+  }
+}
+
+/*************************************************
+* Name:        gen_matrix_il
+*
+* Description: gen_matrix with interleaved rows (see polyvec_il)
+*
+* Arguments:   - polyvec_il *a:       pointer to ouptput matrix A
+*              - const uint8_t *seed: pointer to input seed
+*              - int transposed:      boolean deciding whether A or A^T
+*                                     is generated
+**************************************************/
+void gen_matrix_il(polyvec_il *a,
+                   const uint8_t seed[KYBER_SYMBYTES],
+                   int transposed)
+{
+  unsigned int i, j;
+  poly t;
+
+  for(i=0;i<KYBER_K;i++) {
+    for(j=0;j<KYBER_K;j++) {
+      if(transposed)
+        gen_matrix_entry(&t, seed, i, j);
+      else
+        gen_matrix_entry(&t, seed, j, i);
+      polyvec_il_insert(&a[i], j, &t);
     }
   }
 }
@@ -217,38 +328,146 @@ void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed)
 **************************************************/
 void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                     uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+{
+  indcpa_keypair_scratch s;
+  indcpa_keypair_ctx(pk, sk, &s);
+}
+
+/*************************************************
+* Name:        keypair_derand
+*
+* Description: Body of indcpa_keypair_ctx and indcpa_keypair_derand_ctx.
+*              The seed is expanded in place in the caller's buffer, so
+*              the body adds nothing to the stack of indcpa_keypair_ctx.
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*              - uint8_t *sk: pointer to output private key
+*              - uint8_t *buf: pointer to keygen seed in the first
+*                              KYBER_SYMBYTES of 2*KYBER_SYMBYTES bytes;
+*                              overwritten
+*              - indcpa_keypair_scratch *s: pointer to scratch memory
+**************************************************/
+static void keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           uint8_t buf[2*KYBER_SYMBYTES],
+                           indcpa_keypair_scratch *s)
 {
   unsigned int i;
-  uint8_t buf[2*KYBER_SYMBYTES];
   const uint8_t *publicseed = buf;
   const uint8_t *noiseseed = buf+KYBER_SYMBYTES;
   uint8_t nonce = 0;
-  polyvec a[KYBER_K], e, pkpv, skpv;
 
-  randombytes(buf, KYBER_SYMBYTES);
+  TRACE_BEGIN(TRACE_HASH_G);
   hash_g(buf, buf, KYBER_SYMBYTES);
+  TRACE_END(TRACE_HASH_G);
 
-  gen_a(a, publicseed);
+  TRACE_BEGIN(TRACE_GEN_A);
+  gen_a(s->a, publicseed);
+  TRACE_END(TRACE_GEN_A);
 
+  TRACE_BEGIN(TRACE_NOISE);
   for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(&skpv.vec[i], noiseseed, nonce++);
+    poly_getnoise_eta1(&s->skpv.vec[i], noiseseed, nonce++);
   for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(&e.vec[i], noiseseed, nonce++);
+    poly_getnoise_eta1(&s->e.vec[i], noiseseed, nonce++);
+  TRACE_END(TRACE_NOISE);
 
-  polyvec_ntt(&skpv);
-  polyvec_ntt(&e);
+  TRACE_BEGIN(TRACE_NTT);
+  polyvec_ntt(&s->skpv);
+  polyvec_ntt(&s->e);
+  TRACE_END(TRACE_NTT);
 
   // matrix-vector multiplication
-  for(i=0;i<KYBER_K;i++) {
-    polyvec_pointwise_acc_montgomery(&pkpv.vec[i], &a[i], &skpv);
-    poly_tomont(&pkpv.vec[i]);
-  }
+  TRACE_BEGIN(TRACE_MATVEC);
+  polyvec_interleave(&s->skpvi, &s->skpv);
+  polyvec_il_mulcache_compute(&s->skcache, &s->skpvi);
+  polyvec_il_matrix_pointwise_montgomery(&s->pkpv, s->a, &s->skpvi,
+                                         &s->skcache);
+  for(i=0;i<KYBER_K;i++)
+    poly_tomont(&s->pkpv.vec[i]);
 
-  polyvec_add(&pkpv, &pkpv, &e);
-  polyvec_reduce(&pkpv);
+  polyvec_add(&s->pkpv, &s->pkpv, &s->e);
+  polyvec_reduce(&s->pkpv);
+  TRACE_END(TRACE_MATVEC);
 
-  pack_sk(sk, &skpv);
-  pack_pk(pk, &pkpv, publicseed);
+  TRACE_BEGIN(TRACE_PACK);
+  pack_sk(sk, &s->skpv);
+  pack_pk(pk, &s->pkpv, publicseed);
+  TRACE_END(TRACE_PACK);
+}
+
+/*************************************************
+* Name:        indcpa_keypair_ctx
+*
+* Description: Same as indcpa_keypair, with all polynomial temporaries
+*              kept in caller-provided scratch memory
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                             (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - indcpa_keypair_scratch *s: pointer to scratch memory
+**************************************************/
+void indcpa_keypair_ctx(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                        uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                        indcpa_keypair_scratch *s)
+{
+  uint8_t buf[2*KYBER_SYMBYTES];
+
+  TRACE_BEGIN(TRACE_INDCPA_KEYPAIR);
+  TRACE_BEGIN(TRACE_RANDOMBYTES);
+  randombytes(buf, KYBER_SYMBYTES);
+  TRACE_END(TRACE_RANDOMBYTES);
+  keypair_derand(pk, sk, buf, s);
+  TRACE_END(TRACE_INDCPA_KEYPAIR);
+}
+
+/*************************************************
+* Name:        indcpa_keypair_derand
+*
+* Description: Deterministic variant of indcpa_keypair: the key pair is
+*              derived from a 32-byte seed instead of randombytes, and
+*              the same seed always gives the same key pair
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*                             (of length KYBER_INDCPA_PUBLICKEYBYTES bytes)
+*              - uint8_t *sk: pointer to output private key
+*                             (of length KYBER_INDCPA_SECRETKEYBYTES bytes)
+*              - const uint8_t *coins: pointer to input keygen seed
+*                                      (of length KYBER_SYMBYTES bytes)
+**************************************************/
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES])
+{
+  indcpa_keypair_scratch s;
+  indcpa_keypair_derand_ctx(pk, sk, coins, &s);
+}
+
+/*************************************************
+* Name:        indcpa_keypair_derand_ctx
+*
+* Description: Same as indcpa_keypair_derand, with all polynomial
+*              temporaries kept in caller-provided scratch memory
+*
+* Arguments:   - uint8_t *pk: pointer to output public key
+*              - uint8_t *sk: pointer to output private key
+*              - const uint8_t *coins: pointer to input keygen seed
+*              - indcpa_keypair_scratch *s: pointer to scratch memory
+**************************************************/
+void indcpa_keypair_derand_ctx(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                               uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                               const uint8_t coins[KYBER_SYMBYTES],
+                               indcpa_keypair_scratch *s)
+{
+  unsigned int i;
+  uint8_t buf[2*KYBER_SYMBYTES];
+
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    buf[i] = coins[i];
+  TRACE_BEGIN(TRACE_INDCPA_KEYPAIR);
+  keypair_derand(pk, sk, buf, s);
+  TRACE_END(TRACE_INDCPA_KEYPAIR);
 }
 
 /*************************************************
@@ -272,41 +491,78 @@ void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                 const uint8_t coins[KYBER_SYMBYTES])
+{
+  indcpa_enc_scratch s;
+  indcpa_enc_ctx(c, m, pk, coins, &s);
+}
+
+/*************************************************
+* Name:        indcpa_enc_ctx
+*
+* Description: Same as indcpa_enc, with all polynomial temporaries
+*              kept in caller-provided scratch memory
+*
+* Arguments:   - uint8_t *c:           pointer to output ciphertext
+*                                      (of length KYBER_INDCPA_BYTES bytes)
+*              - const uint8_t *m:     pointer to input message
+*                                      (of length KYBER_INDCPA_MSGBYTES bytes)
+*              - const uint8_t *pk:    pointer to input public key
+*                                      (of length KYBER_INDCPA_PUBLICKEYBYTES)
+*              - const uint8_t *coins: pointer to input random coins
+*                                      (of length KYBER_SYMBYTES)
+*              - indcpa_enc_scratch *s: pointer to scratch memory
+**************************************************/
+void indcpa_enc_ctx(uint8_t c[KYBER_INDCPA_BYTES],
+                    const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                    const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                    const uint8_t coins[KYBER_SYMBYTES],
+                    indcpa_enc_scratch *s)
 {
   unsigned int i;
   uint8_t seed[KYBER_SYMBYTES];
   uint8_t nonce = 0;
-  polyvec sp, pkpv, ep, at[KYBER_K], bp;
-  poly v, k, epp;
 
-  unpack_pk(&pkpv, seed, pk);
-  poly_frommsg(&k, m);
-  gen_at(at, seed);
+  TRACE_BEGIN(TRACE_INDCPA_ENC);
+  TRACE_BEGIN(TRACE_UNPACK_PK);
+  unpack_pk(&s->pkpv, seed, pk);
+  poly_frommsg(&s->k, m);
+  TRACE_END(TRACE_UNPACK_PK);
+  TRACE_BEGIN(TRACE_GEN_AT);
+  gen_at(s->at, seed);
+  TRACE_END(TRACE_GEN_AT);
 
+  TRACE_BEGIN(TRACE_NOISE);
   for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta1(sp.vec+i, coins, nonce++);
+    poly_getnoise_eta1(s->sp.vec+i, coins, nonce++);
   for(i=0;i<KYBER_K;i++)
-    poly_getnoise_eta2(ep.vec+i, coins, nonce++);
-  poly_getnoise_eta2(&epp, coins, nonce++);
+    poly_getnoise_eta2(s->ep.vec+i, coins, nonce++);
+  poly_getnoise_eta2(&s->epp, coins, nonce++);
+  TRACE_END(TRACE_NOISE);
 
-  polyvec_ntt(&sp);
+  TRACE_BEGIN(TRACE_NTT);
+  polyvec_ntt(&s->sp);
+  TRACE_END(TRACE_NTT);
 
   // matrix-vector multiplication
-  for(i=0;i<KYBER_K;i++)
-    polyvec_pointwise_acc_montgomery(&bp.vec[i], &at[i], &sp);
-
-  polyvec_pointwise_acc_montgomery(&v, &pkpv, &sp);
-
-  polyvec_invntt_tomont(&bp);
-  poly_invntt_tomont(&v);
-
-  polyvec_add(&bp, &bp, &ep);
-  poly_add(&v, &v, &epp);
-  poly_add(&v, &v, &k);
-  polyvec_reduce(&bp);
-  poly_reduce(&v);
-
-  pack_ciphertext(c, &bp, &v);
+  TRACE_BEGIN(TRACE_MATVEC);
+  polyvec_interleave(&s->spi, &s->sp);
+  polyvec_il_mulcache_compute(&s->spcache, &s->spi);
+  polyvec_il_matrix_pointwise_montgomery(&s->bp, s->at, &s->spi,
+                                         &s->spcache);
+
+  polyvec_interleave(&s->pkpvi, &s->pkpv);
+  polyvec_il_pointwise_acc_montgomery(&s->v, &s->pkpvi, &s->spi,
+                                      &s->spcache);
+  TRACE_END(TRACE_MATVEC);
+
+  // invntt, noise, reduction and compression fused per polynomial;
+  // the ciphertext is the compressed vector bp followed by compressed v
+  TRACE_BEGIN(TRACE_INVNTT_COMPRESS);
+  polyvec_invntt_add_compress(c, &s->bp, &s->ep);
+  poly_invntt_add_compress(c+KYBER_POLYVECCOMPRESSEDBYTES,
+                           &s->v, &s->epp, &s->k);
+  TRACE_END(TRACE_INVNTT_COMPRESS);
+  TRACE_END(TRACE_INDCPA_ENC);
 }
 
 /*************************************************
@@ -326,18 +582,111 @@ void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
 {
-  polyvec bp, skpv;
-  poly v, mp;
+  indcpa_dec_scratch s;
+  indcpa_dec_ctx(m, c, sk, &s);
+}
 
-  unpack_ciphertext(&bp, &v, c);
-  unpack_sk(&skpv, sk);
+/*************************************************
+* Name:        dec_expanded
+*
+* Description: Body of indcpa_dec_ctx and indcpa_dec_expanded_ctx:
+*              decryption with the secret key in NTT domain and its
+*              multiplication cache
+*
+* Arguments:   - uint8_t *m:        pointer to output decrypted message
+*              - const uint8_t *c:  pointer to input ciphertext
+*              - const polyvec *skpv: pointer to input secret vector
+*              - const polyvec_mulcache *skcache: pointer to its cache
+*              - indcpa_dec_scratch *s: pointer to scratch memory
+**************************************************/
+static void dec_expanded(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                         const uint8_t c[KYBER_INDCPA_BYTES],
+                         const polyvec *skpv,
+                         const polyvec_mulcache *skcache,
+                         indcpa_dec_scratch *s)
+{
+  TRACE_BEGIN(TRACE_UNPACK_CT);
+  polyvec_decompress_ntt(&s->bp, c);
+  poly_decompress(&s->v, c+KYBER_POLYVECCOMPRESSEDBYTES);
+  TRACE_END(TRACE_UNPACK_CT);
+
+  TRACE_BEGIN(TRACE_BASEMUL);
+  polyvec_pointwise_acc_montgomery(&s->mp, &s->bp, skpv, skcache);
+  TRACE_END(TRACE_BASEMUL);
+  TRACE_BEGIN(TRACE_INVNTT);
+  poly_invntt_tomont(&s->mp);
+  TRACE_END(TRACE_INVNTT);
+
+  TRACE_BEGIN(TRACE_TOMSG);
+  poly_sub(&s->mp, &s->v, &s->mp);
+  poly_reduce(&s->mp);
+
+  poly_tomsg(m, &s->mp);
+  TRACE_END(TRACE_TOMSG);
+}
 
-  polyvec_ntt(&bp);
-  polyvec_pointwise_acc_montgomery(&mp, &skpv, &bp);
-  poly_invntt_tomont(&mp);
+/*************************************************
+* Name:        indcpa_dec_ctx
+*
+* Description: Same as indcpa_dec, with all polynomial temporaries
+*              kept in caller-provided scratch memory
+*
+* Arguments:   - uint8_t *m:        pointer to output decrypted message
+*                                   (of length KYBER_INDCPA_MSGBYTES)
+*              - const uint8_t *c:  pointer to input ciphertext
+*                                   (of length KYBER_INDCPA_BYTES)
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+*              - indcpa_dec_scratch *s: pointer to scratch memory
+**************************************************/
+void indcpa_dec_ctx(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                    const uint8_t c[KYBER_INDCPA_BYTES],
+                    const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                    indcpa_dec_scratch *s)
+{
+  TRACE_BEGIN(TRACE_INDCPA_DEC);
+  TRACE_BEGIN(TRACE_UNPACK_SK);
+  unpack_sk(&s->skpv, sk);
+  polyvec_mulcache_compute(&s->skcache, &s->skpv);
+  TRACE_END(TRACE_UNPACK_SK);
+  dec_expanded(m, c, &s->skpv, &s->skcache, s);
+  TRACE_END(TRACE_INDCPA_DEC);
+}
 
-  poly_sub(&mp, &v, &mp);
-  poly_reduce(&mp);
+/*************************************************
+* Name:        indcpa_sk_expand
+*
+* Description: Unpacks a secret key and computes its multiplication
+*              cache once, for any number of indcpa_dec_expanded_ctx
+*
+* Arguments:   - indcpa_sk_expanded *r: pointer to output expanded key
+*              - const uint8_t *sk: pointer to input secret key
+*                                   (of length KYBER_INDCPA_SECRETKEYBYTES)
+**************************************************/
+void indcpa_sk_expand(indcpa_sk_expanded *r,
+                      const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES])
+{
+  unpack_sk(&r->skpv, sk);
+  polyvec_mulcache_compute(&r->skcache, &r->skpv);
+}
 
-  poly_tomsg(m, &mp);
+/*************************************************
+* Name:        indcpa_dec_expanded_ctx
+*
+* Description: Same as indcpa_dec_ctx with an expanded secret key;
+*              skips unpacking the key and computing its cache
+*
+* Arguments:   - uint8_t *m:        pointer to output decrypted message
+*              - const uint8_t *c:  pointer to input ciphertext
+*              - const indcpa_sk_expanded *sk: pointer to input expanded key
+*              - indcpa_dec_scratch *s: pointer to scratch memory
+**************************************************/
+void indcpa_dec_expanded_ctx(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                             const uint8_t c[KYBER_INDCPA_BYTES],
+                             const indcpa_sk_expanded *sk,
+                             indcpa_dec_scratch *s)
+{
+  TRACE_BEGIN(TRACE_INDCPA_DEC);
+  dec_expanded(m, c, &sk->skpv, &sk->skcache, s);
+  TRACE_END(TRACE_INDCPA_DEC);
 }
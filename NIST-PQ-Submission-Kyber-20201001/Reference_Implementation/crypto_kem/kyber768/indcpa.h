@@ -5,21 +5,90 @@
 #include "params.h"
 #include "polyvec.h"
 
+/*
+ * Scratch memory holding all polynomial temporaries of one call to
+ * indcpa_keypair_ctx, indcpa_enc_ctx or indcpa_dec_ctx. The interleaved
+ * members require the alignment of polyvec_il (64 bytes).
+ */
+typedef struct{
+  polyvec_il a[KYBER_K], skpvi;
+  polyvec_il_mulcache skcache;
+  polyvec e, pkpv, skpv;
+} indcpa_keypair_scratch;
+
+typedef struct{
+  polyvec_il at[KYBER_K], spi, pkpvi;
+  polyvec_il_mulcache spcache;
+  polyvec sp, pkpv, ep, bp;
+  poly v, k, epp;
+} indcpa_enc_scratch;
+
+typedef struct{
+  polyvec bp, skpv;
+  polyvec_mulcache skcache;
+  poly v, mp;
+} indcpa_dec_scratch;
+
+/*
+ * Secret key in NTT domain with its multiplication cache; both depend on
+ * the key only and are kept with an expanded key across decryptions.
+ */
+typedef struct{
+  polyvec skpv;
+  polyvec_mulcache skcache;
+} indcpa_sk_expanded;
+
 #define gen_matrix KYBER_NAMESPACE(_gen_matrix)
 void gen_matrix(polyvec *a, const uint8_t seed[KYBER_SYMBYTES], int transposed);
+#define gen_matrix_il KYBER_NAMESPACE(_gen_matrix_il)
+void gen_matrix_il(polyvec_il *a,
+                   const uint8_t seed[KYBER_SYMBYTES],
+                   int transposed);
 #define indcpa_keypair KYBER_NAMESPACE(_indcpa_keypair)
 void indcpa_keypair(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                     uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+#define indcpa_keypair_ctx KYBER_NAMESPACE(_indcpa_keypair_ctx)
+void indcpa_keypair_ctx(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                        uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                        indcpa_keypair_scratch *s);
+#define indcpa_keypair_derand KYBER_NAMESPACE(_indcpa_keypair_derand)
+void indcpa_keypair_derand(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                           uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                           const uint8_t coins[KYBER_SYMBYTES]);
+#define indcpa_keypair_derand_ctx KYBER_NAMESPACE(_indcpa_keypair_derand_ctx)
+void indcpa_keypair_derand_ctx(uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                               uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                               const uint8_t coins[KYBER_SYMBYTES],
+                               indcpa_keypair_scratch *s);
 
 #define indcpa_enc KYBER_NAMESPACE(_indcpa_enc)
 void indcpa_enc(uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
                 const uint8_t coins[KYBER_SYMBYTES]);
+#define indcpa_enc_ctx KYBER_NAMESPACE(_indcpa_enc_ctx)
+void indcpa_enc_ctx(uint8_t c[KYBER_INDCPA_BYTES],
+                    const uint8_t m[KYBER_INDCPA_MSGBYTES],
+                    const uint8_t pk[KYBER_INDCPA_PUBLICKEYBYTES],
+                    const uint8_t coins[KYBER_SYMBYTES],
+                    indcpa_enc_scratch *s);
 
 #define indcpa_dec KYBER_NAMESPACE(_indcpa_dec)
 void indcpa_dec(uint8_t m[KYBER_INDCPA_MSGBYTES],
                 const uint8_t c[KYBER_INDCPA_BYTES],
                 const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+#define indcpa_dec_ctx KYBER_NAMESPACE(_indcpa_dec_ctx)
+void indcpa_dec_ctx(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                    const uint8_t c[KYBER_INDCPA_BYTES],
+                    const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES],
+                    indcpa_dec_scratch *s);
+#define indcpa_sk_expand KYBER_NAMESPACE(_indcpa_sk_expand)
+void indcpa_sk_expand(indcpa_sk_expanded *r,
+                      const uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES]);
+#define indcpa_dec_expanded_ctx KYBER_NAMESPACE(_indcpa_dec_expanded_ctx)
+void indcpa_dec_expanded_ctx(uint8_t m[KYBER_INDCPA_MSGBYTES],
+                             const uint8_t c[KYBER_INDCPA_BYTES],
+                             const indcpa_sk_expanded *sk,
+                             indcpa_dec_scratch *s);
 
 #endif
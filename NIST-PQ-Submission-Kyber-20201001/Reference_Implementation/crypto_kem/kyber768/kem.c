@@ -1,126 +1,608 @@
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "kem.h"
 #include "params.h"
 #include "rng.h"
 #include "symmetric.h"
 #include "verify.h"
 #include "indcpa.h"
+#include "trace.h"
+
+/*
+ * Layout of the scratch context of the _ctx functions. Decapsulation
+ * runs indcpa_dec and the re-encryption one after the other, so their
+ * temporaries share memory; the re-encrypted ciphertext is kept apart.
+ */
+typedef struct{
+  union{
+    indcpa_keypair_scratch keypair;
+    indcpa_enc_scratch enc;
+    indcpa_dec_scratch dec;
+  } indcpa;
+  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
+} kem_scratch;
 
 /*************************************************
-* Name:        crypto_kem_keypair
+* Name:        kem_keypair
 *
-* Description: Generates public and private key
-*              for CCA-secure Kyber key encapsulation mechanism
+* Description: Body of crypto_kem_keypair and crypto_kem_keypair_ctx
 *
 * Arguments:   - unsigned char *pk: pointer to output public key
-*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
 *              - unsigned char *sk: pointer to output private key
-*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - indcpa_keypair_scratch *s: pointer to scratch memory
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+static int kem_keypair(unsigned char *pk,
+                       unsigned char *sk,
+                       indcpa_keypair_scratch *s)
 {
   size_t i;
-  indcpa_keypair(pk, sk);
+  TRACE_BEGIN(TRACE_KEM_KEYPAIR);
+  indcpa_keypair_ctx(pk, sk, s);
   for(i=0;i<KYBER_INDCPA_PUBLICKEYBYTES;i++)
     sk[i+KYBER_INDCPA_SECRETKEYBYTES] = pk[i];
+  TRACE_BEGIN(TRACE_HASH_H);
   hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  TRACE_END(TRACE_HASH_H);
   /* Value z for pseudo-random output on reject */
+  TRACE_BEGIN(TRACE_RANDOMBYTES);
   randombytes(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES);
+  TRACE_END(TRACE_RANDOMBYTES);
+  TRACE_END(TRACE_KEM_KEYPAIR);
   return 0;
 }
 
 /*************************************************
-* Name:        crypto_kem_enc
+* Name:        kem_enc
 *
-* Description: Generates cipher text and shared
-*              secret for given public key
+* Description: Body of crypto_kem_enc and crypto_kem_enc_ctx
 *
 * Arguments:   - unsigned char *ct: pointer to output cipher text
-*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
 *              - unsigned char *ss: pointer to output shared secret
-*                (an already allocated array of CRYPTO_BYTES bytes)
 *              - const unsigned char *pk: pointer to input public key
-*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - indcpa_enc_scratch *s: pointer to scratch memory
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_enc(unsigned char *ct,
+static int kem_enc(unsigned char *ct,
                    unsigned char *ss,
-                   const unsigned char *pk)
+                   const unsigned char *pk,
+                   indcpa_enc_scratch *s)
 {
   uint8_t buf[2*KYBER_SYMBYTES];
   /* Will contain key, coins */
   uint8_t kr[2*KYBER_SYMBYTES];
 
+  TRACE_BEGIN(TRACE_KEM_ENC);
+  TRACE_BEGIN(TRACE_RANDOMBYTES);
   randombytes(buf, KYBER_SYMBYTES);
+  TRACE_END(TRACE_RANDOMBYTES);
   /* Don't release system RNG output */
+  TRACE_BEGIN(TRACE_HASH_H);
   hash_h(buf, buf, KYBER_SYMBYTES);
 
   /* Multitarget countermeasure for coins + contributory KEM */
   hash_h(buf+KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  TRACE_END(TRACE_HASH_H);
+  TRACE_BEGIN(TRACE_HASH_G);
   hash_g(kr, buf, 2*KYBER_SYMBYTES);
+  TRACE_END(TRACE_HASH_G);
 
   /* coins are in kr+KYBER_SYMBYTES */
-  indcpa_enc(ct, buf, pk, kr+KYBER_SYMBYTES);
+  indcpa_enc_ctx(ct, buf, pk, kr+KYBER_SYMBYTES, s);
 
   /* overwrite coins in kr with H(c) */
+  TRACE_BEGIN(TRACE_HASH_H);
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+  TRACE_END(TRACE_HASH_H);
   /* hash concatenation of pre-k and H(c) to k */
+  TRACE_BEGIN(TRACE_KDF);
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+  TRACE_END(TRACE_KDF);
+  TRACE_END(TRACE_KEM_ENC);
   return 0;
 }
 
 /*************************************************
-* Name:        crypto_kem_dec
+* Name:        kem_dec
 *
-* Description: Generates shared secret for given
-*              cipher text and private key
+* Description: Body of crypto_kem_dec, crypto_kem_dec_ctx and
+*              crypto_kem_dec_seed
 *
 * Arguments:   - unsigned char *ss: pointer to output shared secret
-*                (an already allocated array of CRYPTO_BYTES bytes)
 *              - const unsigned char *ct: pointer to input cipher text
-*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
 *              - const unsigned char *sk: pointer to input private key
-*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*              - const indcpa_sk_expanded *esk: pointer to the expanded
+*                indcpa secret key of sk, or NULL to unpack it from sk
+*              - kem_scratch *s: pointer to scratch memory
 *
 * Returns 0.
-*
-* On failure, ss will contain a pseudo-random value.
 **************************************************/
-int crypto_kem_dec(unsigned char *ss,
+static int kem_dec(unsigned char *ss,
                    const unsigned char *ct,
-                   const unsigned char *sk)
+                   const unsigned char *sk,
+                   const indcpa_sk_expanded *esk,
+                   kem_scratch *s)
 {
   size_t i;
   int fail;
   uint8_t buf[2*KYBER_SYMBYTES];
   /* Will contain key, coins */
   uint8_t kr[2*KYBER_SYMBYTES];
-  uint8_t cmp[KYBER_CIPHERTEXTBYTES];
   const uint8_t *pk = sk+KYBER_INDCPA_SECRETKEYBYTES;
 
-  indcpa_dec(buf, ct, sk);
+  TRACE_BEGIN(TRACE_KEM_DEC);
+  if(esk)
+    indcpa_dec_expanded_ctx(buf, ct, esk, &s->indcpa.dec);
+  else
+    indcpa_dec_ctx(buf, ct, sk, &s->indcpa.dec);
 
   /* Multitarget countermeasure for coins + contributory KEM */
   for(i=0;i<KYBER_SYMBYTES;i++)
     buf[KYBER_SYMBYTES+i] = sk[KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES+i];
+  TRACE_BEGIN(TRACE_HASH_G);
   hash_g(kr, buf, 2*KYBER_SYMBYTES);
+  TRACE_END(TRACE_HASH_G);
 
   /* coins are in kr+KYBER_SYMBYTES */
-  indcpa_enc(cmp, buf, pk, kr+KYBER_SYMBYTES);
+  indcpa_enc_ctx(s->cmp, buf, pk, kr+KYBER_SYMBYTES, &s->indcpa.enc);
 
-  fail = verify(ct, cmp, KYBER_CIPHERTEXTBYTES);
+  TRACE_BEGIN(TRACE_VERIFY);
+  fail = verify(ct, s->cmp, KYBER_CIPHERTEXTBYTES);
+  TRACE_END(TRACE_VERIFY);
 
   /* overwrite coins in kr with H(c) */
+  TRACE_BEGIN(TRACE_HASH_H);
   hash_h(kr+KYBER_SYMBYTES, ct, KYBER_CIPHERTEXTBYTES);
+  TRACE_END(TRACE_HASH_H);
 
   /* Overwrite pre-k with z on re-encryption failure */
   cmov(kr, sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, KYBER_SYMBYTES, fail);
 
   /* hash concatenation of pre-k and H(c) to k */
+  TRACE_BEGIN(TRACE_KDF);
   kdf(ss, kr, 2*KYBER_SYMBYTES);
+  TRACE_END(TRACE_KDF);
+  TRACE_END(TRACE_KEM_DEC);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_ctxbytes
+*
+* Description: Returns the size of the scratch context taken by
+*              crypto_kem_keypair_ctx, crypto_kem_enc_ctx and
+*              crypto_kem_dec_ctx. The context must be aligned to
+*              KYBER_CTXALIGN bytes; it holds no state between calls and
+*              can be reused for any number of operations, but not by
+*              two operations at the same time.
+**************************************************/
+size_t crypto_kem_ctxbytes(void)
+{
+  return sizeof(kem_scratch);
+}
+
+/*************************************************
+* Name:        crypto_kem_keypair
+*
+* Description: Generates public and private key
+*              for CCA-secure Kyber key encapsulation mechanism
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
+{
+  indcpa_keypair_scratch s;
+  return kem_keypair(pk, sk, &s);
+}
+
+/*************************************************
+* Name:        crypto_kem_keypair_ctx
+*
+* Description: Same as crypto_kem_keypair, with all large temporaries
+*              kept in a caller-provided scratch context
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*              - unsigned char *sk: pointer to output private key
+*              - void *ctx: pointer to scratch context of
+*                crypto_kem_ctxbytes() bytes, aligned to KYBER_CTXALIGN
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair_ctx(unsigned char *pk, unsigned char *sk, void *ctx)
+{
+  kem_scratch *s = ctx;
+  return kem_keypair(pk, sk, &s->indcpa.keypair);
+}
+
+/*************************************************
+* Name:        crypto_kem_enc
+*
+* Description: Generates cipher text and shared
+*              secret for given public key
+*
+* Arguments:   - unsigned char *ct: pointer to output cipher text
+*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss: pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *pk: pointer to input public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc(unsigned char *ct,
+                   unsigned char *ss,
+                   const unsigned char *pk)
+{
+  indcpa_enc_scratch s;
+  return kem_enc(ct, ss, pk, &s);
+}
+
+/*************************************************
+* Name:        crypto_kem_enc_ctx
+*
+* Description: Same as crypto_kem_enc, with all large temporaries
+*              kept in a caller-provided scratch context
+*
+* Arguments:   - unsigned char *ct: pointer to output cipher text
+*              - unsigned char *ss: pointer to output shared secret
+*              - const unsigned char *pk: pointer to input public key
+*              - void *ctx: pointer to scratch context of
+*                crypto_kem_ctxbytes() bytes, aligned to KYBER_CTXALIGN
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc_ctx(unsigned char *ct,
+                       unsigned char *ss,
+                       const unsigned char *pk,
+                       void *ctx)
+{
+  kem_scratch *s = ctx;
+  return kem_enc(ct, ss, pk, &s->indcpa.enc);
+}
+
+/*************************************************
+* Name:        crypto_kem_dec
+*
+* Description: Generates shared secret for given
+*              cipher text and private key
+*
+* Arguments:   - unsigned char *ss: pointer to output shared secret
+*                (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *ct: pointer to input cipher text
+*                (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - const unsigned char *sk: pointer to input private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes)
+*
+* Returns 0.
+*
+* On failure, ss will contain a pseudo-random value.
+**************************************************/
+int crypto_kem_dec(unsigned char *ss,
+                   const unsigned char *ct,
+                   const unsigned char *sk)
+{
+  kem_scratch s;
+  return kem_dec(ss, ct, sk, NULL, &s);
+}
+
+/*************************************************
+* Name:        crypto_kem_dec_ctx
+*
+* Description: Same as crypto_kem_dec, with all large temporaries
+*              kept in a caller-provided scratch context
+*
+* Arguments:   - unsigned char *ss: pointer to output shared secret
+*              - const unsigned char *ct: pointer to input cipher text
+*              - const unsigned char *sk: pointer to input private key
+*              - void *ctx: pointer to scratch context of
+*                crypto_kem_ctxbytes() bytes, aligned to KYBER_CTXALIGN
+*
+* Returns 0.
+*
+* On failure, ss will contain a pseudo-random value.
+**************************************************/
+int crypto_kem_dec_ctx(unsigned char *ss,
+                       const unsigned char *ct,
+                       const unsigned char *sk,
+                       void *ctx)
+{
+  return kem_dec(ss, ct, sk, NULL, ctx);
+}
+
+/*************************************************
+* Name:        kem_sk_expand
+*
+* Description: Body of crypto_kem_sk_expand and of the expansion in
+*              crypto_kem_skcache_lookup
+*
+* Arguments:   - unsigned char *sk: pointer to output private key
+*              - const unsigned char *seedsk: pointer to input seed key
+*              - indcpa_keypair_scratch *s: pointer to scratch memory
+**************************************************/
+static void kem_sk_expand(unsigned char *sk,
+                          const unsigned char *seedsk,
+                          indcpa_keypair_scratch *s)
+{
+  unsigned char *pk = sk+KYBER_INDCPA_SECRETKEYBYTES;
+
+  indcpa_keypair_derand_ctx(pk, sk, seedsk, s);
+  hash_h(sk+KYBER_SECRETKEYBYTES-2*KYBER_SYMBYTES, pk, KYBER_PUBLICKEYBYTES);
+  memcpy(sk+KYBER_SECRETKEYBYTES-KYBER_SYMBYTES, seedsk+KYBER_SYMBYTES,
+         KYBER_SYMBYTES);
+}
+
+/*************************************************
+* Name:        crypto_kem_keypair_seed
+*
+* Description: Generates a public key and a seed-only private key of
+*              KYBER_SEEDSECRETKEYBYTES bytes (keygen seed and z). With
+*              the same randombytes output, crypto_kem_sk_expand of the
+*              seed key gives the private key of crypto_kem_keypair.
+*
+* Arguments:   - unsigned char *pk: pointer to output public key
+*                (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*              - unsigned char *seedsk: pointer to output seed key
+*                (an already allocated array of KYBER_SEEDSECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_keypair_seed(unsigned char *pk, unsigned char *seedsk)
+{
+  indcpa_keypair_scratch s;
+  uint8_t sk[KYBER_INDCPA_SECRETKEYBYTES];
+
+  TRACE_BEGIN(TRACE_KEM_KEYPAIR);
+  TRACE_BEGIN(TRACE_RANDOMBYTES);
+  randombytes(seedsk, KYBER_SYMBYTES);
+  TRACE_END(TRACE_RANDOMBYTES);
+  indcpa_keypair_derand_ctx(pk, sk, seedsk, &s);
+  /* Value z for pseudo-random output on reject */
+  TRACE_BEGIN(TRACE_RANDOMBYTES);
+  randombytes(seedsk+KYBER_SYMBYTES, KYBER_SYMBYTES);
+  TRACE_END(TRACE_RANDOMBYTES);
+  TRACE_END(TRACE_KEM_KEYPAIR);
   return 0;
 }
+
+/*************************************************
+* Name:        crypto_kem_sk_expand
+*
+* Description: Regenerates the full private key from a seed key
+*
+* Arguments:   - unsigned char *sk: pointer to output private key
+*                (an already allocated array of CRYPTO_SECRETKEYBYTES bytes);
+*                the public key is at sk+KYBER_INDCPA_SECRETKEYBYTES
+*              - const unsigned char *seedsk: pointer to input seed key
+*                (an already allocated array of KYBER_SEEDSECRETKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_sk_expand(unsigned char *sk, const unsigned char *seedsk)
+{
+  indcpa_keypair_scratch s;
+  kem_sk_expand(sk, seedsk, &s);
+  return 0;
+}
+
+/*
+ * Cache of expanded private keys with least-recently-used replacement,
+ * in caller-provided memory: a header, the entries, then the hash
+ * buckets. The entries of a bucket and the LRU order are linked lists
+ * of entry indices.
+ *
+ * An entry holds the private key and the unpacked indcpa secret key
+ * with its multiplication cache, so a hit skips all key-only work in
+ * decapsulation.
+ *
+ * Entries are found through the tag H(seed key). The tags of a bucket
+ * are all compared in constant time, but the lookup is not constant
+ * time as a whole: the memory access pattern reveals which bucket (a
+ * few bits of the tag) and how many entries it holds, and a miss is
+ * much slower than a hit because it expands the key. This shows which
+ * keys are in use, not the keys themselves.
+ */
+#define SKCACHE_NONE 0xFFFFFFFF
+
+typedef struct{
+  uint8_t tag[KYBER_SYMBYTES];
+  uint32_t prev, next, chain;
+  uint8_t sk[KYBER_SECRETKEYBYTES];
+  indcpa_sk_expanded esk;
+} skcache_entry;
+
+typedef struct{
+  kem_scratch scratch;
+  uint32_t nentries, used, mask, head, tail;
+} skcache_header;
+
+#define SKCACHE_HEADERBYTES \
+  ((sizeof(skcache_header) + KYBER_CTXALIGN - 1) / KYBER_CTXALIGN * KYBER_CTXALIGN)
+
+static uint32_t skcache_nbuckets(unsigned int nentries)
+{
+  uint32_t n = 1;
+  while(n < 2*nentries)
+    n <<= 1;
+  return n;
+}
+
+static skcache_entry *skcache_entries(void *cache)
+{
+  return (skcache_entry *)((uint8_t *)cache + SKCACHE_HEADERBYTES);
+}
+
+static uint32_t *skcache_buckets(void *cache)
+{
+  skcache_header *h = cache;
+  return (uint32_t *)(skcache_entries(cache) + h->nentries);
+}
+
+/*************************************************
+* Name:        crypto_kem_skcache_bytes
+*
+* Description: Returns the size of a cache of nentries expanded
+*              private keys. The cache must be aligned to KYBER_CTXALIGN
+*              bytes and must not be used by two operations at the
+*              same time.
+**************************************************/
+size_t crypto_kem_skcache_bytes(unsigned int nentries)
+{
+  return SKCACHE_HEADERBYTES + (size_t)nentries*sizeof(skcache_entry)
+         + (size_t)skcache_nbuckets(nentries)*sizeof(uint32_t);
+}
+
+/*************************************************
+* Name:        crypto_kem_skcache_init
+*
+* Description: Initializes an empty cache
+*
+* Arguments:   - void *cache: pointer to memory of
+*                crypto_kem_skcache_bytes(nentries) bytes
+*              - unsigned int nentries: number of entries, at least 1
+**************************************************/
+void crypto_kem_skcache_init(void *cache, unsigned int nentries)
+{
+  skcache_header *h = cache;
+  uint32_t i, *bucket;
+
+  h->nentries = nentries;
+  h->used = 0;
+  h->mask = skcache_nbuckets(nentries) - 1;
+  h->head = h->tail = SKCACHE_NONE;
+  bucket = skcache_buckets(cache);
+  for(i=0;i<=h->mask;i++)
+    bucket[i] = SKCACHE_NONE;
+}
+
+static void skcache_unlink(skcache_header *h, skcache_entry *e, uint32_t i)
+{
+  if(e[i].prev != SKCACHE_NONE)
+    e[e[i].prev].next = e[i].next;
+  else
+    h->head = e[i].next;
+  if(e[i].next != SKCACHE_NONE)
+    e[e[i].next].prev = e[i].prev;
+  else
+    h->tail = e[i].prev;
+}
+
+static void skcache_push_front(skcache_header *h, skcache_entry *e, uint32_t i)
+{
+  e[i].prev = SKCACHE_NONE;
+  e[i].next = h->head;
+  if(h->head != SKCACHE_NONE)
+    e[h->head].prev = i;
+  else
+    h->tail = i;
+  h->head = i;
+}
+
+static uint32_t skcache_bucket(const skcache_header *h, const uint8_t *tag)
+{
+  return ((uint32_t)tag[0] | (uint32_t)tag[1] << 8 | (uint32_t)tag[2] << 16
+          | (uint32_t)tag[3] << 24) & h->mask;
+}
+
+/*************************************************
+* Name:        skcache_find
+*
+* Description: Body of crypto_kem_skcache_lookup; returns the entry of
+*              a seed key, expanding it on a miss in place of the least
+*              recently used entry
+*
+* Arguments:   - void *cache: pointer to initialized cache
+*              - const unsigned char *seedsk: pointer to input seed key
+*
+* Returns a pointer to the entry, valid until the next lookup
+**************************************************/
+static const skcache_entry *skcache_find(void *cache,
+                                         const unsigned char *seedsk)
+{
+  skcache_header *h = cache;
+  skcache_entry *e = skcache_entries(cache);
+  uint32_t *bucket = skcache_buckets(cache);
+  uint32_t i, hit, mask, *p;
+  uint8_t tag[KYBER_SYMBYTES];
+
+  hash_h(tag, seedsk, KYBER_SEEDSECRETKEYBYTES);
+  hit = SKCACHE_NONE;
+  for(i=bucket[skcache_bucket(h, tag)];i!=SKCACHE_NONE;i=e[i].chain) {
+    /* mask = 0xFFFFFFFF if the tags match; no early exit */
+    mask = (uint32_t)verify(e[i].tag, tag, KYBER_SYMBYTES) - 1;
+    hit = (hit & ~mask) | (i & mask);
+  }
+  if(hit != SKCACHE_NONE) {
+    skcache_unlink(h, e, hit);
+    skcache_push_front(h, e, hit);
+    return &e[hit];
+  }
+
+  if(h->used < h->nentries)
+    i = h->used++;
+  else {
+    /* evict the least recently used entry */
+    i = h->tail;
+    skcache_unlink(h, e, i);
+    for(p=&bucket[skcache_bucket(h, e[i].tag)];*p!=i;p=&e[*p].chain);
+    *p = e[i].chain;
+  }
+
+  kem_sk_expand(e[i].sk, seedsk, &h->scratch.indcpa.keypair);
+  indcpa_sk_expand(&e[i].esk, e[i].sk);
+  memcpy(e[i].tag, tag, KYBER_SYMBYTES);
+  e[i].chain = bucket[skcache_bucket(h, tag)];
+  bucket[skcache_bucket(h, tag)] = i;
+  skcache_push_front(h, e, i);
+  return &e[i];
+}
+
+/*************************************************
+* Name:        crypto_kem_skcache_lookup
+*
+* Description: Returns the expanded private key of a seed key, expanding
+*              it on a miss in place of the least recently used entry
+*
+* Arguments:   - void *cache: pointer to initialized cache
+*              - const unsigned char *seedsk: pointer to input seed key
+*
+* Returns a pointer to the CRYPTO_SECRETKEYBYTES-byte private key inside
+* the cache, valid until the next lookup
+**************************************************/
+const unsigned char *crypto_kem_skcache_lookup(void *cache,
+                                               const unsigned char *seedsk)
+{
+  return skcache_find(cache, seedsk)->sk;
+}
+
+/*************************************************
+* Name:        crypto_kem_dec_seed
+*
+* Description: Same as crypto_kem_dec for a seed-only private key; the
+*              expanded key is taken from the cache
+*
+* Arguments:   - unsigned char *ss: pointer to output shared secret
+*              - const unsigned char *ct: pointer to input cipher text
+*              - const unsigned char *seedsk: pointer to input seed key
+*              - void *cache: pointer to initialized cache
+*
+* Returns 0.
+*
+* On failure, ss will contain a pseudo-random value.
+**************************************************/
+int crypto_kem_dec_seed(unsigned char *ss,
+                        const unsigned char *ct,
+                        const unsigned char *seedsk,
+                        void *cache)
+{
+  skcache_header *h = cache;
+  const skcache_entry *e = skcache_find(cache, seedsk);
+  return kem_dec(ss, ct, e->sk, &e->esk, &h->scratch);
+}
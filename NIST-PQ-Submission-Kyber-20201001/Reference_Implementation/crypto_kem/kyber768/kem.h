@@ -1,8 +1,15 @@
 #ifndef KEM_H
 #define KEM_H
 
+#include <stddef.h>
 #include "params.h"
 
+/* Required alignment of the scratch context of the _ctx functions */
+#define KYBER_CTXALIGN 64
+
+/* Seed-only secret key: keygen seed followed by the reject value z */
+#define KYBER_SEEDSECRETKEYBYTES (2*KYBER_SYMBYTES)
+
 #define crypto_kem_keypair KYBER_NAMESPACE(_keypair)
 int crypto_kem_keypair(unsigned char *pk, unsigned char *sk);
 
@@ -16,4 +23,44 @@ int crypto_kem_dec(unsigned char *ss,
                    const unsigned char *ct,
                    const unsigned char *sk);
 
+#define crypto_kem_ctxbytes KYBER_NAMESPACE(_ctxbytes)
+size_t crypto_kem_ctxbytes(void);
+
+#define crypto_kem_keypair_ctx KYBER_NAMESPACE(_keypair_ctx)
+int crypto_kem_keypair_ctx(unsigned char *pk, unsigned char *sk, void *ctx);
+
+#define crypto_kem_enc_ctx KYBER_NAMESPACE(_enc_ctx)
+int crypto_kem_enc_ctx(unsigned char *ct,
+                       unsigned char *ss,
+                       const unsigned char *pk,
+                       void *ctx);
+
+#define crypto_kem_dec_ctx KYBER_NAMESPACE(_dec_ctx)
+int crypto_kem_dec_ctx(unsigned char *ss,
+                       const unsigned char *ct,
+                       const unsigned char *sk,
+                       void *ctx);
+
+#define crypto_kem_keypair_seed KYBER_NAMESPACE(_keypair_seed)
+int crypto_kem_keypair_seed(unsigned char *pk, unsigned char *seedsk);
+
+#define crypto_kem_sk_expand KYBER_NAMESPACE(_sk_expand)
+int crypto_kem_sk_expand(unsigned char *sk, const unsigned char *seedsk);
+
+#define crypto_kem_skcache_bytes KYBER_NAMESPACE(_skcache_bytes)
+size_t crypto_kem_skcache_bytes(unsigned int nentries);
+
+#define crypto_kem_skcache_init KYBER_NAMESPACE(_skcache_init)
+void crypto_kem_skcache_init(void *cache, unsigned int nentries);
+
+#define crypto_kem_skcache_lookup KYBER_NAMESPACE(_skcache_lookup)
+const unsigned char *crypto_kem_skcache_lookup(void *cache,
+                                               const unsigned char *seedsk);
+
+#define crypto_kem_dec_seed KYBER_NAMESPACE(_dec_seed)
+int crypto_kem_dec_seed(unsigned char *ss,
+                        const unsigned char *ct,
+                        const unsigned char *seedsk,
+                        void *cache);
+
 #endif
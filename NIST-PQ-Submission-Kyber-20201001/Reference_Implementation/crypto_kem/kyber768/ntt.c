@@ -2,6 +2,7 @@
 #include "params.h"
 #include "ntt.h"
 #include "reduce.h"
+#include "opcount.h"
 
 /* Code to generate zetas and zetas_inv used in the number-theoretic transform:
 
@@ -76,6 +77,7 @@ const int16_t zetas_inv[128] = {
 * Returns 16-bit integer congruent to a*b*R^{-1} mod q
 **************************************************/
 static int16_t fqmul(int16_t a, int16_t b) {
+  OPCOUNT_ADD(mul, 1);
   return montgomery_reduce((int32_t)a*b);
 }
 
@@ -92,6 +94,7 @@ void ntt(int16_t r[256]) {
   unsigned int len, start, j, k;
   int16_t t, zeta;
 
+  OPCOUNT_ADD(butterfly, 7*KYBER_N/2);
   k = 1;
   for(len = 128; len >= 2; len >>= 1) {
     for(start = 0; start < 256; start = j + len) {
@@ -106,19 +109,20 @@ void ntt(int16_t r[256]) {
 }
 
 /*************************************************
-* Name:        invntt_tomont
+* Name:        invntt_layers
 *
-* Description: Inplace inverse number-theoretic transform in Rq and
-*              multiplication by Montgomery factor 2^16.
-*              Input is in bitreversed order, output is in standard order
+* Description: Inplace inverse number-theoretic transform in Rq without
+*              the final multiplication by zetas_inv[127], for callers that
+*              fuse it into the loop consuming the output
 *
 * Arguments:   - int16_t r[256]: pointer to input/output vector of elements
 *                                of Zq
 **************************************************/
-void invntt(int16_t r[256]) {
+void invntt_layers(int16_t r[256]) {
   unsigned int start, len, j, k;
   int16_t t, zeta;
 
+  OPCOUNT_ADD(butterfly, 7*KYBER_N/2);
   k = 0;
   for(len = 2; len <= 128; len <<= 1) {
     for(start = 0; start < 256; start = j + len) {
@@ -131,6 +135,22 @@ void invntt(int16_t r[256]) {
       }
     }
   }
+}
+
+/*************************************************
+* Name:        invntt_tomont
+*
+* Description: Inplace inverse number-theoretic transform in Rq and
+*              multiplication by Montgomery factor 2^16.
+*              Input is in bitreversed order, output is in standard order
+*
+* Arguments:   - int16_t r[256]: pointer to input/output vector of elements
+*                                of Zq
+**************************************************/
+void invntt(int16_t r[256]) {
+  unsigned int j;
+
+  invntt_layers(r);
 
   for(j = 0; j < 256; ++j)
     r[j] = fqmul(r[j], zetas_inv[127]);
@@ -140,7 +160,11 @@ void invntt(int16_t r[256]) {
 * Name:        basemul
 *
 * Description: Multiplication of polynomials in Zq[X]/(X^2-zeta)
-*              used for multiplication of elements in Rq in NTT domain
+*              used for multiplication of elements in Rq in NTT domain.
+*              With -DKYBER_KARATSUBA the cross term is computed as
+*              (a0+a1)(b0+b1) - a0b0 - a1b1, which takes 4 instead of 5
+*              multiplications; r[1] is then in {-3q+1,...,3q-1}
+*              instead of {-2q+1,...,2q-1}.
 *
 * Arguments:   - int16_t r[2]:       pointer to the output polynomial
 *              - const int16_t a[2]: pointer to the first factor
@@ -152,10 +176,20 @@ void basemul(int16_t r[2],
              const int16_t b[2],
              int16_t zeta)
 {
+#ifdef KYBER_KARATSUBA
+  int16_t t0, t1;
+
+  t0 = fqmul(a[0], b[0]);
+  t1 = fqmul(a[1], b[1]);
+
+  r[0]  = fqmul(t1, zeta) + t0;
+  r[1]  = fqmul(a[0] + a[1], b[0] + b[1]) - t0 - t1;
+#else
   r[0]  = fqmul(a[1], b[1]);
   r[0]  = fqmul(r[0], zeta);
   r[0] += fqmul(a[0], b[0]);
 
   r[1]  = fqmul(a[0], b[1]);
   r[1] += fqmul(a[1], b[0]);
+#endif
 }
@@ -13,6 +13,9 @@ extern const int16_t zetas_inv[128];
 #define ntt KYBER_NAMESPACE(_ntt)
 void ntt(int16_t poly[256]);
 
+#define invntt_layers KYBER_NAMESPACE(_invntt_layers)
+void invntt_layers(int16_t poly[256]);
+
 #define invntt KYBER_NAMESPACE(_invntt)
 void invntt(int16_t poly[256]);
 
@@ -0,0 +1,75 @@
+#ifndef OPCOUNT_H
+#define OPCOUNT_H
+
+#include <stdint.h>
+#include "params.h"
+
+/*
+ * Operation counters for comparing arithmetic cost, e.g. of the
+ * schoolbook and Karatsuba basemul, in software and hardware terms,
+ * and for the census of primitive work per KEM operation (test_census).
+ * Only compiled in with -DKYBER_OPCOUNT; otherwise all counting
+ * macros expand to nothing.
+ *
+ *   mul:         products of two values mod q (16x16 -> 32 bit)
+ *   montgomery:  calls of montgomery_reduce
+ *   barrett:     calls of barrett_reduce
+ *   csubq:       conditional subtractions of q
+ *   butterfly:   butterflies of the forward and inverse NTT
+ *   keccak:      Keccak-f[1600] permutations, split by caller into
+ *   keccak_shake128, keccak_shake256 and keccak_sha3
+ *   xof_blocks:  XOF output blocks consumed by gen_matrix
+ *   xof_extra_blocks: of these, blocks beyond GEN_MATRIX_NBLOCKS per entry
+ *   xof_entries: matrix entries sampled
+ *   xof_entries_extra: matrix entries that needed more than
+ *                GEN_MATRIX_NBLOCKS blocks
+ *   xof_entry_blocks[b]: matrix entries that took b blocks (the last
+ *                bucket collects all larger counts)
+ *   rej_candidates, rej_rejected: 12-bit candidates of rej_uniform
+ *                looked at and rejected (>= q)
+ *   packed_bytes, unpacked_bytes: bytes written by pack_compress and
+ *                read by unpack_decompress
+ */
+#define OPCOUNT_MAXBLOCKS 16
+
+typedef struct{
+  uint64_t mul;
+  uint64_t montgomery;
+  uint64_t barrett;
+  uint64_t csubq;
+  uint64_t butterfly;
+  uint64_t keccak;
+  uint64_t keccak_shake128;
+  uint64_t keccak_shake256;
+  uint64_t keccak_sha3;
+  uint64_t xof_blocks;
+  uint64_t xof_extra_blocks;
+  uint64_t xof_entries;
+  uint64_t xof_entries_extra;
+  uint64_t xof_entry_blocks[OPCOUNT_MAXBLOCKS];
+  uint64_t rej_candidates;
+  uint64_t rej_rejected;
+  uint64_t packed_bytes;
+  uint64_t unpacked_bytes;
+} opcount_t;
+
+#ifdef KYBER_OPCOUNT
+#define opcount KYBER_NAMESPACE(_opcount)
+extern opcount_t opcount;
+
+#define OPCOUNT_ADD(field, n) (opcount.field += (n))
+/* one matrix entry sampled from nblocks XOF blocks */
+#define OPCOUNT_XOF_ENTRY(nblocks, limit) \
+  (opcount.xof_entries++, \
+   opcount.xof_blocks += (nblocks), \
+   opcount.xof_entry_blocks[(nblocks) < OPCOUNT_MAXBLOCKS \
+                            ? (nblocks) : OPCOUNT_MAXBLOCKS-1]++, \
+   (nblocks) > (limit) \
+     ? (opcount.xof_entries_extra++, \
+        opcount.xof_extra_blocks += (nblocks) - (limit)) : 0)
+#else
+#define OPCOUNT_ADD(field, n) ((void)0)
+#define OPCOUNT_XOF_ENTRY(nblocks, limit) ((void)(nblocks))
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+#include <stdint.h>
+#include "params.h"
+#include "pack.h"
+#include "opcount.h"
+
+/*
+ * Division by q in compress_d is replaced by a multiplication with the
+ * reciprocal M = ceil(2^PACK_QSHIFT/q). For all numerators below 2^27,
+ * i.e. for all inputs in [0,2^15) and d <= 11, the error M*q - 2^38 < q
+ * is small enough that the result equals the exact quotient.
+ */
+#define PACK_QSHIFT 38
+#define PACK_QRECIP (((1ULL << PACK_QSHIFT) + KYBER_Q - 1)/KYBER_Q)
+
+/* The block loops below only have constant shifts once fully unrolled */
+#if defined(__GNUC__)
+#define PACK_UNROLL _Pragma("GCC unroll 12")
+#else
+#define PACK_UNROLL
+#endif
+
+/*************************************************
+* Name:        compress_d
+*
+* Description: Conditionally subtract q and compress to d bits,
+*              i.e. round(2^d/q * x) mod 2^d; d = 12 only subtracts q
+*
+* Arguments:   - int16_t a:      input coefficient in [0,2^15)
+*              - unsigned int d: number of output bits
+*
+* Returns the compressed coefficient
+**************************************************/
+static inline uint16_t compress_d(int16_t a, unsigned int d)
+{
+  uint64_t t;
+
+  a -= KYBER_Q;
+  a += (a >> 15) & KYBER_Q;
+  if(d == 12)
+    return a;
+
+  t = ((uint64_t)(uint16_t)a << d) + KYBER_Q/2;
+  t = (t*PACK_QRECIP) >> PACK_QSHIFT;
+  return t & ((1U << d) - 1);
+}
+
+/*************************************************
+* Name:        decompress_d
+*
+* Description: Decompress from d bits, i.e. round(q/2^d * x);
+*              d = 12 returns the input unchanged
+*
+* Arguments:   - uint16_t t:     input value in [0,2^d)
+*              - unsigned int d: number of input bits
+*
+* Returns the decompressed coefficient
+**************************************************/
+static inline int16_t decompress_d(uint16_t t, unsigned int d)
+{
+  if(d == 12)
+    return t;
+  return ((uint32_t)t*KYBER_Q + (1U << (d-1))) >> d;
+}
+
+/*************************************************
+* Name:        pack_d
+*
+* Description: Compress n coefficients to d bits each and serialize them
+*              as a little-endian bit stream. A block of 8 coefficients
+*              fills exactly d <= 12 bytes, which are assembled in two
+*              64-bit words w0 (bits 0..63) and w1 (bits 64..95).
+*              Inlined with a constant d, all shifts are constant and
+*              the block loops are fully unrolled.
+**************************************************/
+static inline void pack_d(uint8_t *r,
+                          const int16_t *a,
+                          unsigned int n,
+                          unsigned int d)
+{
+  unsigned int i, j, k;
+  uint64_t t, w0, w1;
+
+  for(i=0;i<n/8;i++) {
+    w0 = w1 = 0;
+    PACK_UNROLL
+    for(j=0;j<8;j++) {
+      t = compress_d(a[8*i+j], d);
+      k = j*d;
+      if(k >= 64)
+        w1 |= t << (k-64);
+      else if(k+d > 64) {
+        w0 |= t << k;
+        w1 |= t >> (64-k);
+      }
+      else
+        w0 |= t << k;
+    }
+
+    PACK_UNROLL
+    for(j=0;j<d && j<8;j++)
+      r[j] = w0 >> 8*j;
+    PACK_UNROLL
+    for(j=8;j<d;j++)
+      r[j] = w1 >> 8*(j-8);
+    r += d;
+  }
+}
+
+/*************************************************
+* Name:        unpack_d
+*
+* Description: Inverse of pack_d; reads exactly n*d/8 bytes
+**************************************************/
+static inline void unpack_d(int16_t *r,
+                            const uint8_t *a,
+                            unsigned int n,
+                            unsigned int d)
+{
+  unsigned int i, j, k;
+  uint64_t t, w0, w1;
+
+  for(i=0;i<n/8;i++) {
+    w0 = w1 = 0;
+    PACK_UNROLL
+    for(j=0;j<d && j<8;j++)
+      w0 |= (uint64_t)a[j] << 8*j;
+    PACK_UNROLL
+    for(j=8;j<d;j++)
+      w1 |= (uint64_t)a[j] << 8*(j-8);
+    a += d;
+
+    PACK_UNROLL
+    for(j=0;j<8;j++) {
+      k = j*d;
+      if(k >= 64)
+        t = w1 >> (k-64);
+      else if(k+d > 64)
+        t = (w0 >> k) | (w1 << (64-k));
+      else
+        t = w0 >> k;
+      r[8*i+j] = decompress_d(t & ((1U << d) - 1), d);
+    }
+  }
+}
+
+/*************************************************
+* Name:        pack_compress
+*
+* Description: Conditional subtraction of q, compression to d bits and
+*              serialization of n coefficients in one pass.
+*              d = 12 serializes without compression (poly_tobytes),
+*              d = 1 is the message encoding (poly_tomsg).
+*
+* Arguments:   - uint8_t *r:       pointer to output byte array
+*                                  (of length n*d/8 bytes)
+*              - const int16_t *a: pointer to input coefficients in [0,2^15)
+*              - unsigned int n:   number of coefficients, multiple of 8
+*              - unsigned int d:   bits per coefficient in {1,4,5,10,11,12}
+**************************************************/
+void pack_compress(uint8_t *r, const int16_t *a, unsigned int n, unsigned int d)
+{
+  OPCOUNT_ADD(csubq, n);
+  OPCOUNT_ADD(packed_bytes, n*d/8);
+  switch(d) {
+    case  1: pack_d(r, a, n,  1); break;
+    case  4: pack_d(r, a, n,  4); break;
+    case  5: pack_d(r, a, n,  5); break;
+    case 10: pack_d(r, a, n, 10); break;
+    case 11: pack_d(r, a, n, 11); break;
+    case 12: pack_d(r, a, n, 12); break;
+  }
+}
+
+/*************************************************
+* Name:        unpack_decompress
+*
+* Description: De-serialization and decompression of n coefficients of
+*              d bits each; approximate inverse of pack_compress.
+*              d = 12 de-serializes without decompression (poly_frombytes),
+*              d = 1 is the message decoding (poly_frommsg).
+*
+* Arguments:   - int16_t *r:       pointer to output coefficients
+*              - const uint8_t *a: pointer to input byte array
+*                                  (of length n*d/8 bytes)
+*              - unsigned int n:   number of coefficients, multiple of 8
+*              - unsigned int d:   bits per coefficient in {1,4,5,10,11,12}
+**************************************************/
+void unpack_decompress(int16_t *r, const uint8_t *a, unsigned int n, unsigned int d)
+{
+  OPCOUNT_ADD(unpacked_bytes, n*d/8);
+  switch(d) {
+    case  1: unpack_d(r, a, n,  1); break;
+    case  4: unpack_d(r, a, n,  4); break;
+    case  5: unpack_d(r, a, n,  5); break;
+    case 10: unpack_d(r, a, n, 10); break;
+    case 11: unpack_d(r, a, n, 11); break;
+    case 12: unpack_d(r, a, n, 12); break;
+  }
+}
@@ -0,0 +1,13 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stdint.h>
+#include "params.h"
+
+#define pack_compress KYBER_NAMESPACE(_pack_compress)
+void pack_compress(uint8_t *r, const int16_t *a, unsigned int n, unsigned int d);
+
+#define unpack_decompress KYBER_NAMESPACE(_unpack_decompress)
+void unpack_decompress(int16_t *r, const uint8_t *a, unsigned int n, unsigned int d);
+
+#endif
@@ -5,11 +5,15 @@
 #include "reduce.h"
 #include "cbd.h"
 #include "symmetric.h"
+#include "pack.h"
+#include "opcount.h"
 
 /*************************************************
 * Name:        poly_compress
 *
-* Description: Compression and subsequent serialization of a polynomial
+* Description: Compression and subsequent serialization of a polynomial;
+*              the conditional subtraction of q is fused into the packing
+*              loop, the input polynomial is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (of length KYBER_POLYCOMPRESSEDBYTES)
@@ -17,34 +21,10 @@
 **************************************************/
 void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
 {
-  unsigned int i,j;
-  uint8_t t[8];
-
-  poly_csubq(a);
-
 #if (KYBER_POLYCOMPRESSEDBYTES == 128)
-  for(i=0;i<KYBER_N/8;i++) {
-    for(j=0;j<8;j++)
-      t[j] = ((((uint16_t)a->coeffs[8*i+j] << 4) + KYBER_Q/2)/KYBER_Q) & 15;
-
-    r[0] = t[0] | (t[1] << 4);
-    r[1] = t[2] | (t[3] << 4);
-    r[2] = t[4] | (t[5] << 4);
-    r[3] = t[6] | (t[7] << 4);
-    r += 4;
-  }
+  pack_compress(r, a->coeffs, KYBER_N, 4);
 #elif (KYBER_POLYCOMPRESSEDBYTES == 160)
-  for(i=0;i<KYBER_N/8;i++) {
-    for(j=0;j<8;j++)
-      t[j] = ((((uint32_t)a->coeffs[8*i+j] << 5) + KYBER_Q/2)/KYBER_Q) & 31;
-
-    r[0] = (t[0] >> 0) | (t[1] << 5);
-    r[1] = (t[1] >> 3) | (t[2] << 2) | (t[3] << 7);
-    r[2] = (t[3] >> 1) | (t[4] << 4);
-    r[3] = (t[4] >> 4) | (t[5] << 1) | (t[6] << 6);
-    r[4] = (t[6] >> 2) | (t[7] << 3);
-    r += 5;
-  }
+  pack_compress(r, a->coeffs, KYBER_N, 5);
 #else
 #error "KYBER_POLYCOMPRESSEDBYTES needs to be in {128, 160}"
 #endif
@@ -62,31 +42,10 @@ void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a)
 **************************************************/
 void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES])
 {
-  unsigned int i;
-
 #if (KYBER_POLYCOMPRESSEDBYTES == 128)
-  for(i=0;i<KYBER_N/2;i++) {
-    r->coeffs[2*i+0] = (((uint16_t)(a[0] & 15)*KYBER_Q) + 8) >> 4;
-    r->coeffs[2*i+1] = (((uint16_t)(a[0] >> 4)*KYBER_Q) + 8) >> 4;
-    a += 1;
-  }
+  unpack_decompress(r->coeffs, a, KYBER_N, 4);
 #elif (KYBER_POLYCOMPRESSEDBYTES == 160)
-  unsigned int j;
-  uint8_t t[8];
-  for(i=0;i<KYBER_N/8;i++) {
-    t[0] = (a[0] >> 0);
-    t[1] = (a[0] >> 5) | (a[1] << 3);
-    t[2] = (a[1] >> 2);
-    t[3] = (a[1] >> 7) | (a[2] << 1);
-    t[4] = (a[2] >> 4) | (a[3] << 4);
-    t[5] = (a[3] >> 1);
-    t[6] = (a[3] >> 6) | (a[4] << 2);
-    t[7] = (a[4] >> 3);
-    a += 5;
-
-    for(j=0;j<8;j++)
-      r->coeffs[8*i+j] = ((uint32_t)(t[j] & 31)*KYBER_Q + 16) >> 5;
-  }
+  unpack_decompress(r->coeffs, a, KYBER_N, 5);
 #else
 #error "KYBER_POLYCOMPRESSEDBYTES needs to be in {128, 160}"
 #endif
@@ -95,7 +54,9 @@ void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES])
 /*************************************************
 * Name:        poly_tobytes
 *
-* Description: Serialization of a polynomial
+* Description: Serialization of a polynomial; the conditional subtraction
+*              of q is fused into the packing loop, the input polynomial
+*              is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (needs space for KYBER_POLYBYTES bytes)
@@ -103,18 +64,7 @@ void poly_decompress(poly *r, const uint8_t a[KYBER_POLYCOMPRESSEDBYTES])
 **************************************************/
 void poly_tobytes(uint8_t r[KYBER_POLYBYTES], poly *a)
 {
-  unsigned int i;
-  uint16_t t0, t1;
-
-  poly_csubq(a);
-
-  for(i=0;i<KYBER_N/2;i++) {
-    t0 = a->coeffs[2*i];
-    t1 = a->coeffs[2*i+1];
-    r[3*i+0] = (t0 >> 0);
-    r[3*i+1] = (t0 >> 8) | (t1 << 4);
-    r[3*i+2] = (t1 >> 4);
-  }
+  pack_compress(r, a->coeffs, KYBER_N, 12);
 }
 
 /*************************************************
@@ -129,11 +79,7 @@ void poly_tobytes(uint8_t r[KYBER_POLYBYTES], poly *a)
 **************************************************/
 void poly_frombytes(poly *r, const uint8_t a[KYBER_POLYBYTES])
 {
-  unsigned int i;
-  for(i=0;i<KYBER_N/2;i++) {
-    r->coeffs[2*i]   = ((a[3*i+0] >> 0) | ((uint16_t)a[3*i+1] << 8)) & 0xFFF;
-    r->coeffs[2*i+1] = ((a[3*i+1] >> 4) | ((uint16_t)a[3*i+2] << 4)) & 0xFFF;
-  }
+  unpack_decompress(r->coeffs, a, KYBER_N, 12);
 }
 
 /*************************************************
@@ -146,43 +92,25 @@ void poly_frombytes(poly *r, const uint8_t a[KYBER_POLYBYTES])
 **************************************************/
 void poly_frommsg(poly *r, const uint8_t msg[KYBER_INDCPA_MSGBYTES])
 {
-  unsigned int i,j;
-  int16_t mask;
-
 #if (KYBER_INDCPA_MSGBYTES != KYBER_N/8)
 #error "KYBER_INDCPA_MSGBYTES must be equal to KYBER_N/8 bytes!"
 #endif
 
-  for(i=0;i<KYBER_N/8;i++) {
-    for(j=0;j<8;j++) {
-      mask = -(int16_t)((msg[i] >> j)&1);
-      r->coeffs[8*i+j] = mask & ((KYBER_Q+1)/2);
-    }
-  }
+  unpack_decompress(r->coeffs, msg, KYBER_N, 1);
 }
 
 /*************************************************
 * Name:        poly_tomsg
 *
-* Description: Convert polynomial to 32-byte message
+* Description: Convert polynomial to 32-byte message;
+*              the input polynomial is left unchanged
 *
 * Arguments:   - uint8_t *msg: pointer to output message
 *              - poly *a:      pointer to input polynomial
 **************************************************/
 void poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], poly *a)
 {
-  unsigned int i,j;
-  uint16_t t;
-
-  poly_csubq(a);
-
-  for(i=0;i<KYBER_N/8;i++) {
-    msg[i] = 0;
-    for(j=0;j<8;j++) {
-      t = ((((uint16_t)a->coeffs[8*i+j] << 1) + KYBER_Q/2)/KYBER_Q) & 1;
-      msg[i] |= t << j;
-    }
-  }
+  pack_compress(msg, a->coeffs, KYBER_N, 1);
 }
 
 /*************************************************
@@ -199,9 +127,15 @@ void poly_tomsg(uint8_t msg[KYBER_INDCPA_MSGBYTES], poly *a)
 **************************************************/
 void poly_getnoise_eta1(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce)
 {
+#ifdef KYBER_90S
   uint8_t buf[KYBER_ETA1*KYBER_N/4];
   prf(buf, sizeof(buf), seed, nonce);
   cbd_eta1(r, buf);
+#else
+  keccak_state state;
+  prf_absorb(&state, seed, nonce);
+  cbd_eta1_keccak(r, &state);
+#endif
 }
 
 /*************************************************
@@ -218,9 +152,15 @@ void poly_getnoise_eta1(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t non
 **************************************************/
 void poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t nonce)
 {
+#ifdef KYBER_90S
   uint8_t buf[KYBER_ETA2*KYBER_N/4];
   prf(buf, sizeof(buf), seed, nonce);
   cbd_eta2(r, buf);
+#else
+  keccak_state state;
+  prf_absorb(&state, seed, nonce);
+  cbd_eta2_keccak(r, &state);
+#endif
 }
 
 
@@ -234,22 +174,29 @@ void poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t non
 * Arguments:   - uint16_t *r: pointer to in/output polynomial
 **************************************************/
 // add print before can verify the ntt module
+// build with -DNTT_RTL_CHECK (as make my_test does) to compare every forward
+// NTT, also the one fused into poly_unpack_ntt, against the RTL output
+#ifdef NTT_RTL_CHECK
 #include <stdio.h>
 #include <inttypes.h>
 
+#ifndef NTT_RTL_OUT
+#define NTT_RTL_OUT "/home/pakin/workspace/kyber/vivado/kyber.sim/sim_1/behav/xsim/ntt_out.txt"
+#endif
+
 static inline int16_t mod_q(int32_t x)
 {
     x %= 3329;
     if (x < 0) x += 3329;
     return (int16_t)x;
 }
-void poly_ntt(poly *r)
+
+static void ntt_rtl_check(const poly *r)
 {
-  ntt(r->coeffs);
   FILE *fp;
   int16_t rtl_result[256];
 
-  fp = fopen("/home/pakin/workspace/kyber/vivado/kyber.sim/sim_1/behav/xsim/ntt_out.txt", "r");
+  fp = fopen(NTT_RTL_OUT, "r");
   if (!fp) {
       perror("fopen");
       return;
@@ -275,8 +222,16 @@ void poly_ntt(poly *r)
   }
   for(int i=0; i<256; i++)
     printf("%d : %" PRId16"\n", i, (int16_t)r->coeffs[i]);
-  poly_reduce(r);
+}
+#endif
 
+void poly_ntt(poly *r)
+{
+  ntt(r->coeffs);
+#ifdef NTT_RTL_CHECK
+  ntt_rtl_check(r);
+#endif
+  poly_reduce(r);
 }
 
 /*************************************************
@@ -293,6 +248,100 @@ void poly_invntt_tomont(poly *r)
   invntt(r->coeffs);
 }
 
+/*************************************************
+* Name:        poly_unpack_ntt
+*
+* Description: De-serialization and decompression of a polynomial from d
+*              bits per coefficient, directly followed by the forward NTT
+*              and reduction while the polynomial is still in L1. Same
+*              output as decompression followed by poly_ntt.
+*
+* Arguments:   - poly *r:          pointer to output polynomial
+*              - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_N*d/8 bytes)
+*              - unsigned int d:   bits per coefficient
+**************************************************/
+void poly_unpack_ntt(poly *r, const uint8_t *a, unsigned int d)
+{
+  unpack_decompress(r->coeffs, a, KYBER_N, d);
+  ntt(r->coeffs);
+#ifdef NTT_RTL_CHECK
+  ntt_rtl_check(r);
+#endif
+  poly_reduce(r);
+}
+
+/*************************************************
+* Name:        poly_invntt_add_pack
+*
+* Description: Inverse NTT of a polynomial fused with the rest of its
+*              encryption path: the multiplication by the Montgomery factor,
+*              the addition of e (and m) and the Barrett reduction are done
+*              in one pass, directly followed by compression to d bits
+*              while the polynomial is still in L1. Same output as
+*              poly_invntt_tomont, poly_add, poly_reduce and compression.
+*
+* Arguments:   - uint8_t *r:     pointer to output byte array
+*                                (of length KYBER_N*d/8 bytes)
+*              - poly *a:        pointer to input polynomial, overwritten
+*                                by the inverse NTT layers
+*              - const poly *e:  pointer to polynomial to add
+*              - const poly *m:  pointer to second polynomial to add or NULL
+*              - unsigned int d: bits per coefficient
+**************************************************/
+void poly_invntt_add_pack(uint8_t *r,
+                          poly *a,
+                          const poly *e,
+                          const poly *m,
+                          unsigned int d)
+{
+  unsigned int i,j;
+  int16_t t[16];
+  const int16_t f = zetas_inv[127];
+
+  invntt_layers(a->coeffs);
+  OPCOUNT_ADD(mul, KYBER_N);
+
+  /* blocks of 16 keep the Montgomery and Barrett reductions of different
+     coefficients independent of each other */
+  for(i=0;i<KYBER_N/16;i++) {
+    for(j=0;j<16;j++)
+      t[j] = montgomery_reduce((int32_t)a->coeffs[16*i+j]*f) + e->coeffs[16*i+j];
+    if(m)
+      for(j=0;j<16;j++)
+        t[j] += m->coeffs[16*i+j];
+    for(j=0;j<16;j++)
+      a->coeffs[16*i+j] = barrett_reduce(t[j]);
+  }
+
+  pack_compress(r, a->coeffs, KYBER_N, d);
+}
+
+/*************************************************
+* Name:        poly_invntt_add_compress
+*
+* Description: poly_invntt_add_pack with the compression of poly_compress
+*
+* Arguments:   - uint8_t *r:    pointer to output byte array
+*                               (of length KYBER_POLYCOMPRESSEDBYTES)
+*              - poly *a:       pointer to input polynomial, overwritten
+*              - const poly *e: pointer to polynomial to add
+*              - const poly *m: pointer to second polynomial to add or NULL
+**************************************************/
+void poly_invntt_add_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES],
+                              poly *a,
+                              const poly *e,
+                              const poly *m)
+{
+#if (KYBER_POLYCOMPRESSEDBYTES == 128)
+  poly_invntt_add_pack(r, a, e, m, 4);
+#elif (KYBER_POLYCOMPRESSEDBYTES == 160)
+  poly_invntt_add_pack(r, a, e, m, 5);
+#else
+#error "KYBER_POLYCOMPRESSEDBYTES needs to be in {128, 160}"
+#endif
+}
+
 /*************************************************
 * Name:        poly_basemul_montgomery
 *
@@ -312,6 +361,33 @@ void poly_basemul_montgomery(poly *r, const poly *a, const poly *b)
   }
 }
 
+/*************************************************
+* Name:        poly_mulcache_compute
+*
+* Description: Precompute b_odd*zeta for all degree-1 factors of a
+*              polynomial in NTT domain, for repeated multiplications
+*              with polyvec_pointwise_acc_montgomery
+*
+* Arguments:   - poly_mulcache *c: pointer to output cache
+*              - const poly *b:    pointer to input polynomial
+**************************************************/
+void poly_mulcache_compute(poly_mulcache *c, const poly *b)
+{
+  unsigned int i;
+#ifdef KYBER_KARATSUBA
+  /* the Karatsuba accumulation does not read the cache */
+  (void)c;
+  (void)b;
+  (void)i;
+#else
+  OPCOUNT_ADD(mul, KYBER_N/2);
+  for(i=0;i<KYBER_N/4;i++) {
+    c->coeffs[2*i]   = montgomery_reduce((int32_t)b->coeffs[4*i+1]*zetas[64+i]);
+    c->coeffs[2*i+1] = montgomery_reduce((int32_t)b->coeffs[4*i+3]*-zetas[64+i]);
+  }
+#endif
+}
+
 /*************************************************
 * Name:        poly_tomont
 *
@@ -324,6 +400,7 @@ void poly_tomont(poly *r)
 {
   unsigned int i;
   const int16_t f = (1ULL << 32) % KYBER_Q;
+  OPCOUNT_ADD(mul, KYBER_N);
   for(i=0;i<KYBER_N;i++)
     r->coeffs[i] = montgomery_reduce((int32_t)r->coeffs[i]*f);
 }
@@ -12,6 +12,15 @@ typedef struct{
   int16_t coeffs[KYBER_N];
 } poly;
 
+/*
+ * Multiplication cache of a polynomial b in NTT domain: for every
+ * degree-1 factor Z_q[X]/(X^2-zeta_i) it holds b_odd*zeta_i, the only
+ * product in basemul that does not depend on the other factor
+ */
+typedef struct{
+  int16_t coeffs[KYBER_N/2];
+} poly_mulcache;
+
 #define poly_compress KYBER_NAMESPACE(_poly_compress)
 void poly_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES], poly *a);
 #define poly_decompress KYBER_NAMESPACE(_poly_decompress)
@@ -37,8 +46,23 @@ void poly_getnoise_eta2(poly *r, const uint8_t seed[KYBER_SYMBYTES], uint8_t non
 void poly_ntt(poly *r);
 #define poly_invntt_tomont KYBER_NAMESPACE(_poly_invntt_tomont)
 void poly_invntt_tomont(poly *r);
+#define poly_unpack_ntt KYBER_NAMESPACE(_poly_unpack_ntt)
+void poly_unpack_ntt(poly *r, const uint8_t *a, unsigned int d);
+#define poly_invntt_add_pack KYBER_NAMESPACE(_poly_invntt_add_pack)
+void poly_invntt_add_pack(uint8_t *r,
+                          poly *a,
+                          const poly *e,
+                          const poly *m,
+                          unsigned int d);
+#define poly_invntt_add_compress KYBER_NAMESPACE(_poly_invntt_add_compress)
+void poly_invntt_add_compress(uint8_t r[KYBER_POLYCOMPRESSEDBYTES],
+                              poly *a,
+                              const poly *e,
+                              const poly *m);
 #define poly_basemul_montgomery KYBER_NAMESPACE(_poly_basemul_montgomery)
 void poly_basemul_montgomery(poly *r, const poly *a, const poly *b);
+#define poly_mulcache_compute KYBER_NAMESPACE(_poly_mulcache_compute)
+void poly_mulcache_compute(poly_mulcache *c, const poly *b);
 #define poly_tomont KYBER_NAMESPACE(_poly_tomont)
 void poly_tomont(poly *r);
 
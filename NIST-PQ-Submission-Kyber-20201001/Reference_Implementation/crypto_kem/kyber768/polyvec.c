@@ -1,12 +1,19 @@
+#include <stddef.h>
 #include <stdint.h>
 #include "params.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "ntt.h"
+#include "reduce.h"
+#include "pack.h"
+#include "opcount.h"
 
 /*************************************************
 * Name:        polyvec_compress
 *
-* Description: Compress and serialize vector of polynomials
+* Description: Compress and serialize vector of polynomials;
+*              the conditional subtraction of q is fused into the packing
+*              loop, the input vector is left unchanged
 *
 * Arguments:   - uint8_t *r: pointer to output byte array
 *                            (needs space for KYBER_POLYVECCOMPRESSEDBYTES)
@@ -14,48 +21,14 @@
 **************************************************/
 void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
 {
-  unsigned int i,j,k;
-
-  polyvec_csubq(a);
+  unsigned int i;
 
 #if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
-  uint16_t t[8];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/8;j++) {
-      for(k=0;k<8;k++)
-        t[k] = ((((uint32_t)a->vec[i].coeffs[8*j+k] << 11) + KYBER_Q/2)
-                /KYBER_Q) & 0x7ff;
-
-      r[ 0] = (t[0] >>  0);
-      r[ 1] = (t[0] >>  8) | (t[1] << 3);
-      r[ 2] = (t[1] >>  5) | (t[2] << 6);
-      r[ 3] = (t[2] >>  2);
-      r[ 4] = (t[2] >> 10) | (t[3] << 1);
-      r[ 5] = (t[3] >>  7) | (t[4] << 4);
-      r[ 6] = (t[4] >>  4) | (t[5] << 7);
-      r[ 7] = (t[5] >>  1);
-      r[ 8] = (t[5] >>  9) | (t[6] << 2);
-      r[ 9] = (t[6] >>  6) | (t[7] << 5);
-      r[10] = (t[7] >>  3);
-      r += 11;
-    }
-  }
+  for(i=0;i<KYBER_K;i++)
+    pack_compress(r+352*i, a->vec[i].coeffs, KYBER_N, 11);
 #elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
-  uint16_t t[4];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/4;j++) {
-      for(k=0;k<4;k++)
-        t[k] = ((((uint32_t)a->vec[i].coeffs[4*j+k] << 10) + KYBER_Q/2)
-                / KYBER_Q) & 0x3ff;
-
-      r[0] = (t[0] >> 0);
-      r[1] = (t[0] >> 8) | (t[1] << 2);
-      r[2] = (t[1] >> 6) | (t[2] << 4);
-      r[3] = (t[2] >> 4) | (t[3] << 6);
-      r[4] = (t[3] >> 2);
-      r += 5;
-    }
-  }
+  for(i=0;i<KYBER_K;i++)
+    pack_compress(r+320*i, a->vec[i].coeffs, KYBER_N, 10);
 #else
 #error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
 #endif
@@ -74,40 +47,14 @@ void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a)
 void polyvec_decompress(polyvec *r,
                         const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
 {
-  unsigned int i,j,k;
+  unsigned int i;
 
 #if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
-  uint16_t t[8];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/8;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[ 1] << 8);
-      t[1] = (a[1] >> 3) | ((uint16_t)a[ 2] << 5);
-      t[2] = (a[2] >> 6) | ((uint16_t)a[ 3] << 2) | ((uint16_t)a[4] << 10);
-      t[3] = (a[4] >> 1) | ((uint16_t)a[ 5] << 7);
-      t[4] = (a[5] >> 4) | ((uint16_t)a[ 6] << 4);
-      t[5] = (a[6] >> 7) | ((uint16_t)a[ 7] << 1) | ((uint16_t)a[8] << 9);
-      t[6] = (a[8] >> 2) | ((uint16_t)a[ 9] << 6);
-      t[7] = (a[9] >> 5) | ((uint16_t)a[10] << 3);
-      a += 11;
-
-      for(k=0;k<8;k++)
-        r->vec[i].coeffs[8*j+k] = ((uint32_t)(t[k] & 0x7FF)*KYBER_Q + 1024) >> 11;
-    }
-  }
+  for(i=0;i<KYBER_K;i++)
+    unpack_decompress(r->vec[i].coeffs, a+352*i, KYBER_N, 11);
 #elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
-  uint16_t t[4];
-  for(i=0;i<KYBER_K;i++) {
-    for(j=0;j<KYBER_N/4;j++) {
-      t[0] = (a[0] >> 0) | ((uint16_t)a[1] << 8);
-      t[1] = (a[1] >> 2) | ((uint16_t)a[2] << 6);
-      t[2] = (a[2] >> 4) | ((uint16_t)a[3] << 4);
-      t[3] = (a[3] >> 6) | ((uint16_t)a[4] << 2);
-      a += 5;
-
-      for(k=0;k<4;k++)
-        r->vec[i].coeffs[4*j+k] = ((uint32_t)(t[k] & 0x3FF)*KYBER_Q + 512) >> 10;
-    }
-  }
+  for(i=0;i<KYBER_K;i++)
+    unpack_decompress(r->vec[i].coeffs, a+320*i, KYBER_N, 10);
 #else
 #error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
 #endif
@@ -175,30 +122,308 @@ void polyvec_invntt_tomont(polyvec *r)
     poly_invntt_tomont(&r->vec[i]);
 }
 
+/*************************************************
+* Name:        polyvec_decompress_ntt
+*
+* Description: De-serialize and decompress vector of polynomials fused
+*              with the forward NTT of each polynomial; same output as
+*              polyvec_decompress followed by polyvec_ntt
+*
+* Arguments:   - polyvec *r:       pointer to output vector of polynomials
+*              - const uint8_t *a: pointer to input byte array
+*                                  (of length KYBER_POLYVECCOMPRESSEDBYTES)
+**************************************************/
+void polyvec_decompress_ntt(polyvec *r,
+                            const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES])
+{
+  unsigned int i;
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  for(i=0;i<KYBER_K;i++)
+    poly_unpack_ntt(&r->vec[i], a+352*i, 11);
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  for(i=0;i<KYBER_K;i++)
+    poly_unpack_ntt(&r->vec[i], a+320*i, 10);
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+}
+
+/*************************************************
+* Name:        polyvec_invntt_add_compress
+*
+* Description: Inverse NTT, addition of e, reduction, compression and
+*              serialization fused per polynomial; same output as
+*              polyvec_invntt_tomont, polyvec_add, polyvec_reduce and
+*              polyvec_compress
+*
+* Arguments:   - uint8_t *r:       pointer to output byte array
+*                                  (needs space for KYBER_POLYVECCOMPRESSEDBYTES)
+*              - polyvec *a:       pointer to input vector of polynomials,
+*                                  overwritten
+*              - const polyvec *e: pointer to vector of polynomials to add
+**************************************************/
+void polyvec_invntt_add_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES],
+                                 polyvec *a,
+                                 const polyvec *e)
+{
+  unsigned int i;
+
+#if (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 352))
+  for(i=0;i<KYBER_K;i++)
+    poly_invntt_add_pack(r+352*i, &a->vec[i], &e->vec[i], NULL, 11);
+#elif (KYBER_POLYVECCOMPRESSEDBYTES == (KYBER_K * 320))
+  for(i=0;i<KYBER_K;i++)
+    poly_invntt_add_pack(r+320*i, &a->vec[i], &e->vec[i], NULL, 10);
+#else
+#error "KYBER_POLYVECCOMPRESSEDBYTES needs to be in {320*KYBER_K, 352*KYBER_K}"
+#endif
+}
+
+#if KYBER_K > 4
+#error "The 32-bit accumulation bound only holds for KYBER_K <= 4"
+#endif
+
+/*
+ * Per-pair kernel of polyvec_pointwise_acc_montgomery and
+ * polyvec_il_pointwise_acc_montgomery, which only differ in the layout
+ * they read: basemul_acc adds the product of the degree-1 factors x and
+ * y to the accumulators t of one output pair, basemul_reduce turns the
+ * accumulators of output pair i into its two coefficients. yc points to
+ * the cached y[1]*zeta and is not read with KYBER_KARATSUBA.
+ */
+#ifdef KYBER_KARATSUBA
+#define BASEMUL_NACC 3
+#define BASEMUL_ACC_MULS ((3*KYBER_K + 1)*KYBER_N/2)
+#else
+#define BASEMUL_NACC 2
+#define BASEMUL_ACC_MULS (4*KYBER_K*KYBER_N/2)
+#endif
+
+static inline void basemul_acc(int32_t t[BASEMUL_NACC],
+                               const int16_t x[2],
+                               const int16_t y[2],
+                               const int16_t *yc)
+{
+#ifdef KYBER_KARATSUBA
+  (void)yc;
+  t[0] += (int32_t)x[0]*y[0];
+  t[2] += (int32_t)x[1]*y[1];
+  t[1] += (int32_t)(x[0] + x[1])*(y[0] + y[1]);
+#else
+  t[0] += (int32_t)x[1]*yc[0];
+  t[0] += (int32_t)x[0]*y[0];
+  t[1] += (int32_t)x[0]*y[1];
+  t[1] += (int32_t)x[1]*y[0];
+#endif
+}
+
+static inline void basemul_reduce(int16_t r[2],
+                                  int32_t t[BASEMUL_NACC],
+                                  unsigned int i)
+{
+#ifdef KYBER_KARATSUBA
+  int16_t zeta = (i & 1) ? -zetas[64+i/2] : zetas[64+i/2];
+  t[1] -= t[0] + t[2];
+  t[0] += (int32_t)montgomery_reduce(t[2])*zeta;
+#else
+  (void)i;
+#endif
+  r[0] = montgomery_reduce(t[0]);
+  r[1] = montgomery_reduce(t[1]);
+}
+
 /*************************************************
 * Name:        polyvec_pointwise_acc_montgomery
 *
 * Description: Pointwise multiply elements of a and b, accumulate into r,
 *              and multiply by 2^-16.
+*              The products of all KYBER_K basemuls are accumulated
+*              unreduced in 32 bits, like a multiply-accumulate unit, and
+*              every output coefficient is Montgomery-reduced once.
+*              The factor b1*zeta of the a1*b1*zeta term is taken from the
+*              multiplication cache of b (see polyvec_mulcache_compute).
+*
+*              Overflow bound: coefficients of a and b are at most 4095 in
+*              absolute value (12-bit deserialized keys) and one of them is
+*              at most q (NTT output after Barrett reduction, or rejection
+*              sampled); cached values are below q. Per term,
+*                |a0*b0 + a1*(b1*zeta)| <= 2*4095*q = 27264510,
+*                |a0*b1 + a1*b0|        <= 2*4095*q = 27264510,
+*              so for KYBER_K <= 4 both accumulators stay below
+*              4*27264510 = 109058040 < q*2^15 = 109084672, the input
+*              range of montgomery_reduce.
 *
-* Arguments: - poly *r:          pointer to output polynomial
+*              With -DKYBER_KARATSUBA the cache is not used. The sums
+*              s0 = sum a0*b0, s1 = sum a1*b1 and t = sum (a0+a1)*(b0+b1)
+*              are accumulated instead, and the outputs are
+*              mont(s0 + mont(s1)*zeta) and mont(t - s0 - s1). That takes
+*              3 multiplications per term plus one zeta multiplication
+*              per output pair, and the result is congruent modulo q to
+*              the schoolbook result. s0 and s1 are bounded by
+*              4*4095*q = 54529020, s0 + mont(s1)*zeta by 54529020 + q*q,
+*              and t by 4*(2*4095)*(2*q) = 218116080 < 2^31; t - s0 - s1
+*              is the schoolbook cross term bounded above.
+*
+* Arguments: - poly *r:          pointer to output polynomial with
+*                                coefficients in {-q+1,...,q-1}
 *            - const polyvec *a: pointer to first input vector of polynomials
 *            - const polyvec *b: pointer to second input vector of polynomials
+*            - const polyvec_mulcache *bc: pointer to multiplication cache
+*                                of b
 **************************************************/
 void polyvec_pointwise_acc_montgomery(poly *r,
                                       const polyvec *a,
-                                      const polyvec *b)
+                                      const polyvec *b,
+                                      const polyvec_mulcache *bc)
+{
+  unsigned int i,k;
+  int32_t t[BASEMUL_NACC];
+
+  OPCOUNT_ADD(mul, BASEMUL_ACC_MULS);
+  for(i=0;i<KYBER_N/2;i++) {
+    for(k=0;k<BASEMUL_NACC;k++)
+      t[k] = 0;
+    for(k=0;k<KYBER_K;k++)
+      basemul_acc(t, &a->vec[k].coeffs[2*i], &b->vec[k].coeffs[2*i],
+                  &bc->vec[k].coeffs[i]);
+    basemul_reduce(&r->coeffs[2*i], t, i);
+  }
+}
+
+/*************************************************
+* Name:        polyvec_mulcache_compute
+*
+* Description: Compute the multiplication caches of all elements of a
+*              vector of polynomials in NTT domain; to be done once per
+*              operand that is multiplied repeatedly
+*
+* Arguments: - polyvec_mulcache *c: pointer to output caches
+*            - const polyvec *b:    pointer to input vector of polynomials
+**************************************************/
+void polyvec_mulcache_compute(polyvec_mulcache *c, const polyvec *b)
+{
+  unsigned int i;
+  for(i=0;i<KYBER_K;i++)
+    poly_mulcache_compute(&c->vec[i], &b->vec[i]);
+}
+
+/*************************************************
+* Name:        polyvec_interleave
+*
+* Description: Convert a vector of polynomials to the interleaved layout
+*
+* Arguments: - polyvec_il *r:    pointer to output interleaved vector
+*            - const polyvec *a: pointer to input vector of polynomials
+**************************************************/
+void polyvec_interleave(polyvec_il *r, const polyvec *a)
+{
+  unsigned int i;
+  for(i=0;i<KYBER_K;i++)
+    polyvec_il_insert(r, i, &a->vec[i]);
+}
+
+/*************************************************
+* Name:        polyvec_il_insert
+*
+* Description: Store a polynomial as the k-th element of an interleaved
+*              vector of polynomials
+*
+* Arguments: - polyvec_il *r:  pointer to output interleaved vector
+*            - unsigned int k: index of the element, in {0,...,KYBER_K-1}
+*            - const poly *a:  pointer to input polynomial
+**************************************************/
+void polyvec_il_insert(polyvec_il *r, unsigned int k, const poly *a)
 {
   unsigned int i;
-  poly t;
+  for(i=0;i<KYBER_N/2;i++) {
+    r->coeffs[i][k][0] = a->coeffs[2*i];
+    r->coeffs[i][k][1] = a->coeffs[2*i+1];
+  }
+}
 
-  poly_basemul_montgomery(r, &a->vec[0], &b->vec[0]);
-  for(i=1;i<KYBER_K;i++) {
-    poly_basemul_montgomery(&t, &a->vec[i], &b->vec[i]);
-    poly_add(r, r, &t);
+/*************************************************
+* Name:        polyvec_il_pointwise_acc_montgomery
+*
+* Description: polyvec_pointwise_acc_montgomery on the interleaved layout;
+*              same arithmetic, output and bounds
+*
+* Arguments: - poly *r:             pointer to output polynomial with
+*                                   coefficients in {-q+1,...,q-1}
+*            - const polyvec_il *a: pointer to first interleaved vector
+*            - const polyvec_il *b: pointer to second interleaved vector
+*            - const polyvec_il_mulcache *bc: pointer to multiplication
+*                                   cache of b
+**************************************************/
+void polyvec_il_pointwise_acc_montgomery(poly *r,
+                                         const polyvec_il *a,
+                                         const polyvec_il *b,
+                                         const polyvec_il_mulcache *bc)
+{
+  unsigned int i,k;
+  int32_t t[BASEMUL_NACC];
+
+  OPCOUNT_ADD(mul, BASEMUL_ACC_MULS);
+  for(i=0;i<KYBER_N/2;i++) {
+    for(k=0;k<BASEMUL_NACC;k++)
+      t[k] = 0;
+    for(k=0;k<KYBER_K;k++)
+      basemul_acc(t, a->coeffs[i][k], b->coeffs[i][k], &bc->coeffs[i][k]);
+    basemul_reduce(&r->coeffs[2*i], t, i);
   }
+}
 
-  poly_reduce(r);
+/*************************************************
+* Name:        polyvec_il_matrix_pointwise_montgomery
+*
+* Description: Matrix-vector product in NTT domain on a matrix with
+*              interleaved rows: every row of a is multiplied with b by
+*              polyvec_il_pointwise_acc_montgomery
+*
+* Arguments: - polyvec *r:          pointer to output vector of polynomials
+*            - const polyvec_il *a: pointer to input matrix
+*                                   (array of KYBER_K interleaved rows)
+*            - const polyvec_il *b: pointer to input interleaved vector
+*            - const polyvec_il_mulcache *bc: pointer to multiplication
+*                                   cache of b
+**************************************************/
+void polyvec_il_matrix_pointwise_montgomery(polyvec *r,
+                                            const polyvec_il a[KYBER_K],
+                                            const polyvec_il *b,
+                                            const polyvec_il_mulcache *bc)
+{
+  unsigned int i;
+  for(i=0;i<KYBER_K;i++)
+    polyvec_il_pointwise_acc_montgomery(&r->vec[i], &a[i], b, bc);
+}
+
+/*************************************************
+* Name:        polyvec_il_mulcache_compute
+*
+* Description: polyvec_mulcache_compute for an interleaved vector
+*
+* Arguments: - polyvec_il_mulcache *c: pointer to output cache
+*            - const polyvec_il *b:    pointer to input interleaved vector
+**************************************************/
+void polyvec_il_mulcache_compute(polyvec_il_mulcache *c, const polyvec_il *b)
+{
+  unsigned int i,k;
+  int16_t zeta;
+#ifdef KYBER_KARATSUBA
+  /* the Karatsuba accumulation does not read the cache */
+  (void)c;
+  (void)b;
+  (void)i;
+  (void)k;
+  (void)zeta;
+#else
+  OPCOUNT_ADD(mul, KYBER_K*KYBER_N/2);
+  for(i=0;i<KYBER_N/2;i++) {
+    zeta = (i & 1) ? -zetas[64+i/2] : zetas[64+i/2];
+    for(k=0;k<KYBER_K;k++)
+      c->coeffs[i][k] = montgomery_reduce((int32_t)b->coeffs[i][k][1]*zeta);
+  }
+#endif
 }
 
 /*************************************************
@@ -9,6 +9,32 @@ typedef struct{
   poly vec[KYBER_K];
 } polyvec;
 
+typedef struct{
+  poly_mulcache vec[KYBER_K];
+} polyvec_mulcache;
+
+#if defined(__GNUC__)
+#define POLYVEC_ALIGN __attribute__((aligned(64)))
+#else
+#define POLYVEC_ALIGN
+#endif
+
+/*
+ * Interleaved layout of a vector of polynomials in NTT domain, e.g. a
+ * row of the matrix: coeffs[i][k] is the i-th degree-1 factor
+ * (coefficients 2i and 2i+1) of the k-th polynomial, so the inputs of
+ * one output pair of an inner product are adjacent in memory and an
+ * inner product reads every operand as a single sequential stream.
+ * Aligned to cache lines.
+ */
+typedef struct{
+  int16_t coeffs[KYBER_N/2][KYBER_K][2];
+} POLYVEC_ALIGN polyvec_il;
+
+typedef struct{
+  int16_t coeffs[KYBER_N/2][KYBER_K];
+} POLYVEC_ALIGN polyvec_il_mulcache;
+
 #define polyvec_compress KYBER_NAMESPACE(_polyvec_compress)
 void polyvec_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES], polyvec *a);
 #define polyvec_decompress KYBER_NAMESPACE(_polyvec_decompress)
@@ -25,11 +51,44 @@ void polyvec_ntt(polyvec *r);
 #define polyvec_invntt_tomont KYBER_NAMESPACE(_polyvec_invntt_tomont)
 void polyvec_invntt_tomont(polyvec *r);
 
+#define polyvec_decompress_ntt KYBER_NAMESPACE(_polyvec_decompress_ntt)
+void polyvec_decompress_ntt(polyvec *r,
+                            const uint8_t a[KYBER_POLYVECCOMPRESSEDBYTES]);
+#define polyvec_invntt_add_compress \
+        KYBER_NAMESPACE(_polyvec_invntt_add_compress)
+void polyvec_invntt_add_compress(uint8_t r[KYBER_POLYVECCOMPRESSEDBYTES],
+                                 polyvec *a,
+                                 const polyvec *e);
+
 #define polyvec_pointwise_acc_montgomery \
         KYBER_NAMESPACE(_polyvec_pointwise_acc_montgomery)
 void polyvec_pointwise_acc_montgomery(poly *r,
                                       const polyvec *a,
-                                      const polyvec *b);
+                                      const polyvec *b,
+                                      const polyvec_mulcache *bc);
+#define polyvec_mulcache_compute KYBER_NAMESPACE(_polyvec_mulcache_compute)
+void polyvec_mulcache_compute(polyvec_mulcache *c, const polyvec *b);
+
+#define polyvec_interleave KYBER_NAMESPACE(_polyvec_interleave)
+void polyvec_interleave(polyvec_il *r, const polyvec *a);
+#define polyvec_il_insert KYBER_NAMESPACE(_polyvec_il_insert)
+void polyvec_il_insert(polyvec_il *r, unsigned int k, const poly *a);
+
+#define polyvec_il_pointwise_acc_montgomery \
+        KYBER_NAMESPACE(_polyvec_il_pointwise_acc_montgomery)
+void polyvec_il_pointwise_acc_montgomery(poly *r,
+                                         const polyvec_il *a,
+                                         const polyvec_il *b,
+                                         const polyvec_il_mulcache *bc);
+#define polyvec_il_matrix_pointwise_montgomery \
+        KYBER_NAMESPACE(_polyvec_il_matrix_pointwise_montgomery)
+void polyvec_il_matrix_pointwise_montgomery(polyvec *r,
+                                            const polyvec_il a[KYBER_K],
+                                            const polyvec_il *b,
+                                            const polyvec_il_mulcache *bc);
+#define polyvec_il_mulcache_compute \
+        KYBER_NAMESPACE(_polyvec_il_mulcache_compute)
+void polyvec_il_mulcache_compute(polyvec_il_mulcache *c, const polyvec_il *b);
 
 #define polyvec_reduce KYBER_NAMESPACE(_polyvec_reduce)
 void polyvec_reduce(polyvec *r);
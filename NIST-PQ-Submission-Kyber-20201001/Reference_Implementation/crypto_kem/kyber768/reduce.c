@@ -1,6 +1,11 @@
 #include <stdint.h>
 #include "params.h"
 #include "reduce.h"
+#include "opcount.h"
+
+#ifdef KYBER_OPCOUNT
+opcount_t opcount;
+#endif
 
 /*************************************************
 * Name:        montgomery_reduce
@@ -19,6 +24,7 @@ int16_t montgomery_reduce(int32_t a)
   int32_t t;
   int16_t u;
 
+  OPCOUNT_ADD(montgomery, 1);
   u = a*QINV;
   t = (int32_t)u*KYBER_Q;
   t = a - t;
@@ -40,6 +46,7 @@ int16_t barrett_reduce(int16_t a) {
   int16_t t;
   const int16_t v = ((1U << 26) + KYBER_Q/2)/KYBER_Q;
 
+  OPCOUNT_ADD(barrett, 1);
   t  = (int32_t)v*a >> 26;
   t *= KYBER_Q;
   return a - t;
@@ -55,6 +62,7 @@ int16_t barrett_reduce(int16_t a) {
 * Returns:     a - q if a >= q, else a
 **************************************************/
 int16_t csubq(int16_t a) {
+  OPCOUNT_ADD(csubq, 1);
   a -= KYBER_Q;
   a += (a >> 15) & KYBER_Q;
   return a;
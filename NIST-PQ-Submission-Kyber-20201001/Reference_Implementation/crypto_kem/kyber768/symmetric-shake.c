@@ -29,7 +29,33 @@ void kyber_shake128_absorb(keccak_state *state,
   extseed[i++] = x;
   extseed[i]   = y;
 
-  shake128_absorb(state, extseed, sizeof(extseed));
+  shake128_absorb_34(state, extseed);
+}
+
+/*************************************************
+* Name:        kyber_shake256_prf_absorb
+*
+* Description: Absorb step of kyber_shake256_prf; the output is read
+*              from the state with keccak_permute
+*
+* Arguments:   - keccak_state *state: pointer to (uninitialized) output
+*                                     Keccak state
+*              - const uint8_t *key:  pointer to the key
+*                                     (of length KYBER_SYMBYTES)
+*              - uint8_t nonce:       single-byte nonce (public PRF input)
+**************************************************/
+void kyber_shake256_prf_absorb(keccak_state *state,
+                               const uint8_t key[KYBER_SYMBYTES],
+                               uint8_t nonce)
+{
+  unsigned int i;
+  uint8_t extkey[KYBER_SYMBYTES+1];
+
+  for(i=0;i<KYBER_SYMBYTES;i++)
+    extkey[i] = key[i];
+  extkey[i] = nonce;
+
+  shake256_absorb_33(state, extkey);
 }
 
 /*************************************************
@@ -56,5 +82,10 @@ void kyber_shake256_prf(uint8_t *out,
     extkey[i] = key[i];
   extkey[i] = nonce;
 
-  shake256(out, outlen, extkey, sizeof(extkey));
+  if(outlen == 128)
+    shake256_33_128(out, extkey);
+  else if(outlen == 192)
+    shake256_33_192(out, extkey);
+  else
+    shake256(out, outlen, extkey, sizeof(extkey));
 }
@@ -58,16 +58,36 @@ void kyber_shake256_prf(uint8_t *out,
                         const uint8_t key[KYBER_SYMBYTES],
                         uint8_t nonce);
 
+#define kyber_shake256_prf_absorb KYBER_NAMESPACE(_kyber_shake256_prf_absorb)
+void kyber_shake256_prf_absorb(keccak_state *state,
+                               const uint8_t key[KYBER_SYMBYTES],
+                               uint8_t nonce);
+
 #define XOF_BLOCKBYTES SHAKE128_RATE
 
-#define hash_h(OUT, IN, INBYTES) sha3_256(OUT, IN, INBYTES)
-#define hash_g(OUT, IN, INBYTES) sha3_512(OUT, IN, INBYTES)
+/* the length checks fold at compile time and select the fixed-shape
+   functions of fips202.h for the short inputs */
+#define hash_h(OUT, IN, INBYTES) \
+        ((INBYTES) == 32 ? sha3_256_32(OUT, IN) \
+                         : sha3_256(OUT, IN, INBYTES))
+#define hash_g(OUT, IN, INBYTES) \
+        ((INBYTES) == 32 ? sha3_512_32(OUT, IN) \
+       : (INBYTES) == 64 ? sha3_512_64(OUT, IN) \
+                         : sha3_512(OUT, IN, INBYTES))
 #define xof_absorb(STATE, SEED, X, Y) kyber_shake128_absorb(STATE, SEED, X, Y)
 #define xof_squeezeblocks(OUT, OUTBLOCKS, STATE) \
         shake128_squeezeblocks(OUT, OUTBLOCKS, STATE)
 #define prf(OUT, OUTBYTES, KEY, NONCE) \
         kyber_shake256_prf(OUT, OUTBYTES, KEY, NONCE)
+#define prf_absorb(STATE, KEY, NONCE) \
+        kyber_shake256_prf_absorb(STATE, KEY, NONCE)
+#if KYBER_SSBYTES == 32
+#define kdf(OUT, IN, INBYTES) \
+        ((INBYTES) == 64 ? shake256_64_32(OUT, IN) \
+                         : shake256(OUT, KYBER_SSBYTES, IN, INBYTES))
+#else
 #define kdf(OUT, IN, INBYTES) shake256(OUT, KYBER_SSBYTES, IN, INBYTES)
+#endif
 
 #endif /* KYBER_90S */
 
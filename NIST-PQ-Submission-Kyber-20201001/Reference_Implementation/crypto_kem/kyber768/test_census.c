@@ -0,0 +1,192 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "api.h"
+#include "params.h"
+#include "rng.h"
+#include "opcount.h"
+
+#ifndef KYBER_OPCOUNT
+#error "test_census needs to be compiled with -DKYBER_OPCOUNT"
+#endif
+
+/*
+ * Census of primitive work per KEM operation: runs keypair, encaps and
+ * decaps on fresh random seeds and reports the distribution of every
+ * counter of opcount.h over all runs, plus the number of XOF blocks per
+ * matrix entry of gen_matrix.
+ *
+ * usage: test_census [runs [seed]]   (default 10000 runs, seed 0)
+ */
+
+#define HISTSIZE 4096
+
+static const struct {
+  const char *name;
+  size_t offset;
+} fields[] = {
+  { "mul",               offsetof(opcount_t, mul) },
+  { "montgomery",        offsetof(opcount_t, montgomery) },
+  { "barrett",           offsetof(opcount_t, barrett) },
+  { "csubq",             offsetof(opcount_t, csubq) },
+  { "butterfly",         offsetof(opcount_t, butterfly) },
+  { "keccak",            offsetof(opcount_t, keccak) },
+  { "keccak_shake128",   offsetof(opcount_t, keccak_shake128) },
+  { "keccak_shake256",   offsetof(opcount_t, keccak_shake256) },
+  { "keccak_sha3",       offsetof(opcount_t, keccak_sha3) },
+  { "xof_blocks",        offsetof(opcount_t, xof_blocks) },
+  { "xof_extra_blocks",  offsetof(opcount_t, xof_extra_blocks) },
+  { "xof_entries_extra", offsetof(opcount_t, xof_entries_extra) },
+  { "rej_candidates",    offsetof(opcount_t, rej_candidates) },
+  { "rej_rejected",      offsetof(opcount_t, rej_rejected) },
+  { "packed_bytes",      offsetof(opcount_t, packed_bytes) },
+  { "unpacked_bytes",    offsetof(opcount_t, unpacked_bytes) },
+};
+#define NFIELDS (sizeof(fields)/sizeof(fields[0]))
+
+enum { KEYPAIR, ENCAPS, DECAPS, NOPS };
+static const char *op_name[NOPS] = { "keypair", "encaps", "decaps" };
+
+/* exact counts for values in [base, base+HISTSIZE), beyond only min/max */
+typedef struct {
+  uint64_t n, min, max, base, outside;
+  double sum, sumsq;
+  uint32_t hist[HISTSIZE];
+} stat;
+
+static stat stats[NOPS][NFIELDS];
+static uint64_t entry_blocks[NOPS][OPCOUNT_MAXBLOCKS];
+static uint64_t entries[NOPS];
+static uint64_t runs_extra[NOPS];
+static uint64_t unattributed[NOPS];
+
+static void record(unsigned int op)
+{
+  unsigned int i;
+  uint64_t v;
+  stat *s;
+
+  for(i=0;i<NFIELDS;i++) {
+    s = &stats[op][i];
+    memcpy(&v, (const uint8_t *)&opcount + fields[i].offset, sizeof(v));
+    if(s->n == 0) {
+      s->min = s->max = v;
+      s->base = v > HISTSIZE/2 ? v - HISTSIZE/2 : 0;
+    }
+    s->n++;
+    s->sum += (double)v;
+    s->sumsq += (double)v*v;
+    if(v < s->min) s->min = v;
+    if(v > s->max) s->max = v;
+    if(v - s->base < HISTSIZE && v >= s->base)
+      s->hist[v - s->base]++;
+    else
+      s->outside++;
+  }
+  for(i=0;i<OPCOUNT_MAXBLOCKS;i++)
+    entry_blocks[op][i] += opcount.xof_entry_blocks[i];
+  entries[op] += opcount.xof_entries;
+  runs_extra[op] += (opcount.xof_entries_extra > 0);
+  unattributed[op] += opcount.keccak != opcount.keccak_shake128
+                    + opcount.keccak_shake256 + opcount.keccak_sha3;
+  memset(&opcount, 0, sizeof(opcount));
+}
+
+/* q-quantile, q in parts per million; values outside the histogram
+   window are reported as min or max */
+static uint64_t quantile(const stat *s, uint64_t q)
+{
+  uint64_t rank, seen = 0;
+  unsigned int i;
+
+  rank = (s->n*q + 999999)/1000000;
+  if(rank == 0)
+    rank = 1;
+  for(i=0;i<HISTSIZE;i++) {
+    seen += s->hist[i];
+    if(seen >= rank)
+      return s->base + i;
+  }
+  return s->max;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long long i, runs = 10000;
+  unsigned int op, j;
+  uint8_t entropy[48];
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key_a[CRYPTO_BYTES];
+  uint8_t key_b[CRYPTO_BYTES];
+  const stat *s;
+  double mean;
+
+  if(argc > 1)
+    runs = strtoull(argv[1], NULL, 0);
+  for(j=0;j<48;j++)
+    entropy[j] = (uint8_t)j;
+  if(argc > 2)
+    entropy[0] ^= (uint8_t)strtoul(argv[2], NULL, 0);
+  if(runs == 0)
+    return 1;
+  randombytes_init(entropy, NULL, 256);
+
+  memset(&opcount, 0, sizeof(opcount));
+  for(i=0;i<runs;i++) {
+    crypto_kem_keypair(pk, sk);
+    record(KEYPAIR);
+    crypto_kem_enc(ct, key_b, pk);
+    record(ENCAPS);
+    crypto_kem_dec(key_a, ct, sk);
+    record(DECAPS);
+    if(memcmp(key_a, key_b, CRYPTO_BYTES)) {
+      printf("ERROR keys\n");
+      return 1;
+    }
+  }
+
+  printf("%s, %llu runs\n", CRYPTO_ALGNAME, runs);
+  printf("%-8s %-18s %12s %10s %9s %9s %9s %9s %9s\n", "op", "counter",
+         "mean", "stddev", "min", "median", "p99", "p99.99", "max");
+  for(op=0;op<NOPS;op++) {
+    for(j=0;j<NFIELDS;j++) {
+      s = &stats[op][j];
+      if(s->max == 0)
+        continue;
+      mean = s->sum/s->n;
+      printf("%-8s %-18s %12.2f %10.2f %9llu %9llu %9llu %9llu %9llu%s\n",
+             op_name[op], fields[j].name, mean,
+             sqrt(fmax(s->sumsq/s->n - mean*mean, 0)),
+             (unsigned long long)s->min,
+             (unsigned long long)quantile(s, 500000),
+             (unsigned long long)quantile(s, 990000),
+             (unsigned long long)quantile(s, 999900),
+             (unsigned long long)s->max,
+             s->outside ? "  (quantiles clipped)" : "");
+    }
+    if(unattributed[op])
+      printf("%-8s WARNING keccak permutations not all attributed to a caller\n",
+             op_name[op]);
+  }
+
+  printf("\nXOF blocks per gen_matrix entry\n");
+  for(op=0;op<NOPS;op++) {
+    if(entries[op] == 0)
+      continue;
+    printf("%-8s entries: %llu, runs with an entry beyond GEN_MATRIX_NBLOCKS: "
+           "%llu (%.3g)\n", op_name[op], (unsigned long long)entries[op],
+           (unsigned long long)runs_extra[op], (double)runs_extra[op]/runs);
+    for(j=0;j<OPCOUNT_MAXBLOCKS;j++)
+      if(entry_blocks[op][j])
+        printf("  %s%2u blocks: %12llu (%.6g)\n",
+               j == OPCOUNT_MAXBLOCKS-1 ? ">=" : "  ", j,
+               (unsigned long long)entry_blocks[op][j],
+               (double)entry_blocks[op][j]/entries[op]);
+  }
+  return 0;
+}
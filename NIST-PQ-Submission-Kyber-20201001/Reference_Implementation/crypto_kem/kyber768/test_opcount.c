@@ -0,0 +1,50 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "api.h"
+#include "params.h"
+#include "opcount.h"
+
+#ifndef KYBER_OPCOUNT
+#error "test_opcount needs to be compiled with -DKYBER_OPCOUNT"
+#endif
+
+static void print_counts(const char *s)
+{
+  printf("%-16s mul: %7llu  montgomery: %7llu  barrett: %7llu  csubq: %7llu\n",
+         s,
+         (unsigned long long)opcount.mul,
+         (unsigned long long)opcount.montgomery,
+         (unsigned long long)opcount.barrett,
+         (unsigned long long)opcount.csubq);
+  memset(&opcount, 0, sizeof(opcount));
+}
+
+int main()
+{
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key_a[CRYPTO_BYTES];
+  uint8_t key_b[CRYPTO_BYTES];
+
+#ifdef KYBER_KARATSUBA
+  printf("%s, Karatsuba basemul\n", CRYPTO_ALGNAME);
+#else
+  printf("%s, schoolbook basemul\n", CRYPTO_ALGNAME);
+#endif
+
+  memset(&opcount, 0, sizeof(opcount));
+  crypto_kem_keypair(pk, sk);
+  print_counts("kyber_keypair:");
+  crypto_kem_enc(ct, key_b, pk);
+  print_counts("kyber_encaps:");
+  crypto_kem_dec(key_a, ct, sk);
+  print_counts("kyber_decaps:");
+
+  if(memcmp(key_a, key_b, CRYPTO_BYTES)) {
+    printf("ERROR keys\n");
+    return 1;
+  }
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include "indcpa.h"
 #include "poly.h"
 #include "polyvec.h"
+#include "symmetric.h"
 #include "cpucycles.h"
 #include "speed_print.h"
 
@@ -28,6 +29,9 @@ int main()
   unsigned char kexkey[KEX_SSBYTES] = {0};
   polyvec matrix[KYBER_K];
   poly ap;
+  unsigned char seedsk[2][CRYPTO_SEEDSECRETKEYBYTES];
+  unsigned char pk2[CRYPTO_PUBLICKEYBYTES];
+  void *ctx, *cache;
 
   for(i=0;i<NTESTS;i++) {
     t[i] = cpucycles();
@@ -59,6 +63,61 @@ int main()
   }
   print_results("INVNTT: ", t, NTESTS);
 
+#ifndef KYBER_90S
+  {
+    uint8_t buf[2*SHAKE256_RATE];
+    keccak_state state;
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      shake128_absorb_34(&state, buf);
+    }
+    print_results("shake128_absorb_34: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      shake256_absorb_33(&state, buf);
+    }
+    print_results("shake256_absorb_33: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      shake256_33_128(buf, buf);
+    }
+    print_results("shake256_33_128: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      shake256_33_192(buf, buf);
+    }
+    print_results("shake256_33_192: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      shake256_64_32(buf, buf);
+    }
+    print_results("shake256_64_32: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      sha3_256_32(buf, buf);
+    }
+    print_results("sha3_256_32: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      sha3_512_32(buf, buf);
+    }
+    print_results("sha3_512_32: ", t, NTESTS);
+
+    for(i=0;i<NTESTS;i++) {
+      t[i] = cpucycles();
+      sha3_512_64(buf, buf);
+    }
+    print_results("sha3_512_64: ", t, NTESTS);
+  }
+#endif
+
   for(i=0;i<NTESTS;i++) {
     t[i] = cpucycles();
     crypto_kem_keypair(pk, sk);
@@ -77,6 +136,70 @@ int main()
   }
   print_results("kyber_decaps: ", t, NTESTS);
 
+  ctx = aligned_alloc(CRYPTO_CTXALIGN,
+                      (crypto_kem_ctxbytes() + CRYPTO_CTXALIGN - 1)
+                      / CRYPTO_CTXALIGN * CRYPTO_CTXALIGN);
+  if(ctx == NULL)
+    return 1;
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_keypair_ctx(pk, sk, ctx);
+  }
+  print_results("kyber_keypair_ctx: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_enc_ctx(ct, key, pk, ctx);
+  }
+  print_results("kyber_encaps_ctx: ", t, NTESTS);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_dec_ctx(key, ct, sk, ctx);
+  }
+  print_results("kyber_decaps_ctx: ", t, NTESTS);
+
+  free(ctx);
+
+  /* Seed-only private keys: CRYPTO_SEEDSECRETKEYBYTES stored instead of
+   * CRYPTO_SECRETKEYBYTES, paid for by re-expansion on a cache miss */
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_keypair_seed(pk, seedsk[0]);
+  }
+  print_results("kyber_keypair_seed: ", t, NTESTS);
+  crypto_kem_keypair_seed(pk2, seedsk[1]);
+
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_sk_expand(sk, seedsk[0]);
+  }
+  print_results("kyber_sk_expand: ", t, NTESTS);
+
+  cache = aligned_alloc(CRYPTO_CTXALIGN,
+                        (crypto_kem_skcache_bytes(1) + CRYPTO_CTXALIGN - 1)
+                        / CRYPTO_CTXALIGN * CRYPTO_CTXALIGN);
+  if(cache == NULL)
+    return 1;
+  crypto_kem_skcache_init(cache, 1);
+
+  crypto_kem_enc(ct, key, pk);
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_dec_seed(key, ct, seedsk[0], cache);
+  }
+  print_results("kyber_decaps_seed (cache hit): ", t, NTESTS);
+
+  /* two keys alternating in a single-entry cache always miss */
+  for(i=0;i<NTESTS;i++) {
+    t[i] = cpucycles();
+    crypto_kem_dec_seed(key, ct, seedsk[i&1], cache);
+  }
+  print_results("kyber_decaps_seed (cache miss): ", t, NTESTS);
+
+  free(cache);
+
   for(i=0;i<NTESTS;i++) {
     t[i] = cpucycles();
     kex_uake_initA(kexsenda, key, sk, pk);
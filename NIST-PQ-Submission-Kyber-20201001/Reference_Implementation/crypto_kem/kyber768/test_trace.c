@@ -0,0 +1,76 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "api.h"
+#include "params.h"
+#include "trace.h"
+
+#ifndef KYBER_TRACE
+#error "test_trace needs to be compiled with -DKYBER_TRACE"
+#endif
+
+#define NTESTS 100
+
+static void print_summary(const char *s)
+{
+  trace_stats st[TRACE_NPHASES];
+  unsigned int i;
+
+  trace_summary(st);
+  printf("%s\n", s);
+  for(i=0;i<TRACE_NPHASES;i++) {
+    if(st[i].count == 0)
+      continue;
+    printf("  %-16s n: %5llu  min: %8llu  median: %8llu  p90: %8llu  max: %8llu\n",
+           trace_phase_name[i],
+           (unsigned long long)st[i].count,
+           (unsigned long long)st[i].min,
+           (unsigned long long)st[i].median,
+           (unsigned long long)st[i].p90,
+           (unsigned long long)st[i].max);
+  }
+  trace_reset();
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int i;
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t key_a[CRYPTO_BYTES];
+  uint8_t key_b[CRYPTO_BYTES];
+  FILE *f;
+
+  printf("%s, cycles per phase over %d calls\n", CRYPTO_ALGNAME, NTESTS);
+
+  trace_reset();
+  for(i=0;i<NTESTS;i++)
+    crypto_kem_keypair(pk, sk);
+  print_summary("kyber_keypair:");
+  for(i=0;i<NTESTS;i++)
+    crypto_kem_enc(ct, key_b, pk);
+  print_summary("kyber_encaps:");
+  for(i=0;i<NTESTS;i++)
+    crypto_kem_dec(key_a, ct, sk);
+  print_summary("kyber_decaps:");
+
+  if(memcmp(key_a, key_b, CRYPTO_BYTES)) {
+    printf("ERROR keys\n");
+    return 1;
+  }
+
+  /* one traced run of all operations for chrome://tracing or Perfetto */
+  if(argc > 1) {
+    crypto_kem_keypair(pk, sk);
+    crypto_kem_enc(ct, key_b, pk);
+    crypto_kem_dec(key_a, ct, sk);
+    f = fopen(argv[1], "w");
+    if(f == NULL || trace_export_chrome(f, 0, 1000) || fclose(f)) {
+      printf("ERROR writing %s\n", argv[1]);
+      return 1;
+    }
+    printf("trace written to %s (timestamps in kilocycles)\n", argv[1]);
+  }
+  return 0;
+}
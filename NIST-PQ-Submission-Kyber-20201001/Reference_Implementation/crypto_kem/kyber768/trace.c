@@ -0,0 +1,229 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "params.h"
+#include "trace.h"
+
+#ifdef KYBER_TRACE
+
+const char *const trace_phase_name[TRACE_NPHASES] = {
+  "kem_keypair",
+  "kem_enc",
+  "kem_dec",
+  "indcpa_keypair",
+  "indcpa_enc",
+  "indcpa_dec",
+  "randombytes",
+  "hash_g",
+  "hash_h",
+  "kdf",
+  "gen_a",
+  "gen_at",
+  "noise",
+  "ntt",
+  "matvec",
+  "invntt_compress",
+  "pack",
+  "unpack_pk",
+  "unpack_sk",
+  "unpack_ct",
+  "basemul",
+  "invntt",
+  "tomsg",
+  "verify",
+};
+
+static __thread trace_event ring[TRACE_RINGSIZE];
+static __thread uint64_t written;
+
+#if defined(__x86_64__)
+static inline uint64_t cycles(void)
+{
+  uint64_t result;
+
+  __asm__ volatile ("rdtsc; shlq $32,%%rdx; orq %%rdx,%%rax"
+    : "=a" (result) : : "%rdx");
+  return result;
+}
+#elif defined(__aarch64__)
+static inline uint64_t cycles(void)
+{
+  uint64_t result;
+
+  __asm__ volatile ("mrs %0, cntvct_el0" : "=r" (result));
+  return result;
+}
+#else
+#include <time.h>
+static inline uint64_t cycles(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static void record(unsigned int phase, unsigned int end)
+{
+  trace_event *e = &ring[written++ % TRACE_RINGSIZE];
+
+  e->t = cycles();
+  e->phase = (uint16_t)phase;
+  e->end = (uint16_t)end;
+}
+
+/* index of the oldest event still in the ring */
+static uint64_t first(void)
+{
+  return written < TRACE_RINGSIZE ? 0 : written - TRACE_RINGSIZE;
+}
+
+/*************************************************
+* Name:        trace_begin
+*
+* Description: Record the start of a phase in the ring buffer of the
+*              calling thread
+*
+* Arguments:   - unsigned int phase: phase (enum trace_phase)
+**************************************************/
+void trace_begin(unsigned int phase)
+{
+  record(phase, 0);
+}
+
+/*************************************************
+* Name:        trace_end
+*
+* Description: Record the end of a phase in the ring buffer of the
+*              calling thread
+*
+* Arguments:   - unsigned int phase: phase (enum trace_phase)
+**************************************************/
+void trace_end(unsigned int phase)
+{
+  record(phase, 1);
+}
+
+/*************************************************
+* Name:        trace_reset
+*
+* Description: Discard all events of the calling thread
+**************************************************/
+void trace_reset(void)
+{
+  written = 0;
+}
+
+/*************************************************
+* Name:        trace_events
+*
+* Description: Copy the events of the calling thread, oldest first
+*
+* Arguments:   - trace_event *out: pointer to output events
+*              - unsigned int max: maximum number of events to copy
+*
+* Returns the number of events copied; if more than max events are
+* available, the most recent ones are returned.
+**************************************************/
+unsigned int trace_events(trace_event *out, unsigned int max)
+{
+  uint64_t i, n = written - first();
+
+  if(n > max)
+    n = max;
+  for(i=0;i<n;i++)
+    out[i] = ring[(written - n + i) % TRACE_RINGSIZE];
+  return (unsigned int)n;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/*************************************************
+* Name:        trace_summary
+*
+* Description: Aggregate the durations of all complete phases in the
+*              ring buffer of the calling thread. An end event is paired
+*              with the latest begin event of the same phase; events
+*              whose partner was overwritten are ignored.
+*
+* Arguments:   - trace_stats *st: pointer to output statistics, one
+*                entry per phase, durations in cycles
+**************************************************/
+void trace_summary(trace_stats st[TRACE_NPHASES])
+{
+  /* duration in the low 56 bits, phase above, so that sorting groups
+     the durations of a phase in ascending order */
+  static __thread uint64_t d[TRACE_RINGSIZE/2];
+  uint64_t begin[TRACE_NPHASES];
+  int open[TRACE_NPHASES] = {0};
+  const trace_event *e;
+  uint64_t t;
+  unsigned int i, j, k, nd = 0;
+
+  for(t=first();t<written;t++) {
+    e = &ring[t % TRACE_RINGSIZE];
+    if(!e->end) {
+      begin[e->phase] = e->t;
+      open[e->phase] = 1;
+    }
+    else if(open[e->phase]) {
+      d[nd++] = ((uint64_t)e->phase << 56)
+              | ((e->t - begin[e->phase]) & ((1ULL << 56) - 1));
+      open[e->phase] = 0;
+    }
+  }
+  qsort(d, nd, sizeof(d[0]), cmp_u64);
+
+  for(i=0,j=0;i<TRACE_NPHASES;i++) {
+    st[i].count = st[i].total = 0;
+    st[i].min = st[i].median = st[i].p90 = st[i].max = 0;
+    for(k=j;k<nd && (d[k] >> 56) == i;k++)
+      st[i].total += d[k] & ((1ULL << 56) - 1);
+    if(k == j)
+      continue;
+    st[i].count = k - j;
+    st[i].min = d[j] & ((1ULL << 56) - 1);
+    st[i].median = d[j + (k-j)/2] & ((1ULL << 56) - 1);
+    st[i].p90 = d[j + (k-j)*9/10] & ((1ULL << 56) - 1);
+    st[i].max = d[k-1] & ((1ULL << 56) - 1);
+    j = k;
+  }
+}
+
+/*************************************************
+* Name:        trace_export_chrome
+*
+* Description: Write the events of the calling thread in the Chrome
+*              trace event format (chrome://tracing, Perfetto)
+*
+* Arguments:   - FILE *f:              output stream
+*              - unsigned int tid:     thread id written into the events
+*              - double cycles_per_us: timestamp ticks per microsecond;
+*                pass 1000 to show kilocycles as microseconds
+*
+* Returns 0 on success, -1 on write error
+**************************************************/
+int trace_export_chrome(FILE *f, unsigned int tid, double cycles_per_us)
+{
+  uint64_t t, t0 = ring[first() % TRACE_RINGSIZE].t;
+  const trace_event *e;
+
+  fprintf(f, "{\"traceEvents\":[\n");
+  for(t=first();t<written;t++) {
+    e = &ring[t % TRACE_RINGSIZE];
+    fprintf(f, "{\"name\":\"%s\",\"cat\":\"kyber\",\"ph\":\"%c\","
+               "\"ts\":%.3f,\"pid\":1,\"tid\":%u}%s\n",
+            trace_phase_name[e->phase], e->end ? 'E' : 'B',
+            (double)(e->t - t0) / cycles_per_us, tid,
+            t+1 < written ? "," : "");
+  }
+  fprintf(f, "]}\n");
+  return ferror(f) ? -1 : 0;
+}
+
+#endif
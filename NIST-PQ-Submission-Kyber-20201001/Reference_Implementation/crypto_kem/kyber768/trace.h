@@ -0,0 +1,88 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "params.h"
+
+/*
+ * Phase timing of the KEM and CPA operations. Only compiled in with
+ * -DKYBER_TRACE; otherwise all tracing macros expand to nothing.
+ *
+ * TRACE_BEGIN/TRACE_END append a timestamped event to a ring buffer of
+ * TRACE_RINGSIZE events owned by the calling thread; when it is full the
+ * oldest events are overwritten. Phases nest (e.g. ntt inside
+ * indcpa_enc inside kem_dec), but a phase never nests in itself.
+ * Timestamps are cycles (time stamp counter on x86_64, virtual counter
+ * on aarch64, nanoseconds elsewhere).
+ */
+enum trace_phase {
+  TRACE_KEM_KEYPAIR,
+  TRACE_KEM_ENC,
+  TRACE_KEM_DEC,
+  TRACE_INDCPA_KEYPAIR,
+  TRACE_INDCPA_ENC,
+  TRACE_INDCPA_DEC,
+  TRACE_RANDOMBYTES,
+  TRACE_HASH_G,
+  TRACE_HASH_H,
+  TRACE_KDF,
+  TRACE_GEN_A,
+  TRACE_GEN_AT,
+  TRACE_NOISE,
+  TRACE_NTT,
+  TRACE_MATVEC,
+  TRACE_INVNTT_COMPRESS,
+  TRACE_PACK,
+  TRACE_UNPACK_PK,
+  TRACE_UNPACK_SK,
+  TRACE_UNPACK_CT,
+  TRACE_BASEMUL,
+  TRACE_INVNTT,
+  TRACE_TOMSG,
+  TRACE_VERIFY,
+  TRACE_NPHASES
+};
+
+#define TRACE_RINGSIZE 8192
+
+typedef struct{
+  uint64_t t;
+  uint16_t phase;
+  uint16_t end;
+} trace_event;
+
+typedef struct{
+  uint64_t count;
+  uint64_t total;
+  uint64_t min;
+  uint64_t median;
+  uint64_t p90;
+  uint64_t max;
+} trace_stats;
+
+#ifdef KYBER_TRACE
+#define trace_phase_name KYBER_NAMESPACE(_trace_phase_name)
+extern const char *const trace_phase_name[TRACE_NPHASES];
+
+#define trace_begin KYBER_NAMESPACE(_trace_begin)
+void trace_begin(unsigned int phase);
+#define trace_end KYBER_NAMESPACE(_trace_end)
+void trace_end(unsigned int phase);
+#define trace_reset KYBER_NAMESPACE(_trace_reset)
+void trace_reset(void);
+#define trace_events KYBER_NAMESPACE(_trace_events)
+unsigned int trace_events(trace_event *out, unsigned int max);
+#define trace_summary KYBER_NAMESPACE(_trace_summary)
+void trace_summary(trace_stats st[TRACE_NPHASES]);
+#define trace_export_chrome KYBER_NAMESPACE(_trace_export_chrome)
+int trace_export_chrome(FILE *f, unsigned int tid, double cycles_per_us);
+
+#define TRACE_BEGIN(phase) trace_begin(phase)
+#define TRACE_END(phase) trace_end(phase)
+#else
+#define TRACE_BEGIN(phase) ((void)0)
+#define TRACE_END(phase) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,362 @@
+/*
+ * Benchmark driver shared by all implementations.
+ *
+ * The same source is linked against every implementation and parameter
+ * set (see the Makefile); primitives an implementation does not provide
+ * are detected through the namespacing macros of its headers and skipped.
+ * Every benchmark times NTESTS single calls and reports the distribution
+ * in cycles (nanoseconds on targets without a cycle counter, see
+ * cpucycles.h), with the timer overhead subtracted.
+ *
+ * With -p every benchmark is run a second time, ntests calls inside one
+ * perf_event_open counter group (see perf.h), and the per-call event
+ * counts and the IPC are reported next to the cycle distribution. The
+ * counters are kept out of the timed run so that they do not perturb it.
+ *
+ * With -f raw the summary is replaced by the individual call durations,
+ * one line per benchmark, preceded by the environment the binary was
+ * built and run in (CPU model, compiler, flags, commit). Files in this
+ * format are the baselines compared by compare.c.
+ *
+ * usage: bench [-f json|csv|raw] [-n ntests] [-p] [-H]
+ *   -f  output format: JSON Lines (default), CSV or raw samples
+ *   -n  number of timed calls per benchmark (default 1000)
+ *   -p  add hardware event counts
+ *   -H  print the CSV header (with event columns if -p comes first)
+ *       and exit
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "api.h"
+#include "params.h"
+#include "indcpa.h"
+#include "poly.h"
+#include "polyvec.h"
+#include "cpucycles.h"
+#include "perf.h"
+
+#ifdef PQCLEAN_NAMESPACE
+/* PQClean layout: every exported name carries the scheme prefix */
+#define BENCH_CAT_(a,b) a##b
+#define BENCH_CAT(a,b) BENCH_CAT_(a,b)
+#define BENCH_NS(s) BENCH_CAT(PQCLEAN_NAMESPACE,s)
+#define CRYPTO_PUBLICKEYBYTES BENCH_NS(CRYPTO_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES BENCH_NS(CRYPTO_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES BENCH_NS(CRYPTO_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES BENCH_NS(CRYPTO_BYTES)
+#define CRYPTO_ALGNAME BENCH_NS(CRYPTO_ALGNAME)
+#define crypto_kem_keypair BENCH_NS(crypto_kem_keypair)
+#define crypto_kem_enc BENCH_NS(crypto_kem_enc)
+#define crypto_kem_dec BENCH_NS(crypto_kem_dec)
+#define gen_matrix BENCH_NS(gen_matrix)
+#define indcpa_keypair BENCH_NS(indcpa_keypair)
+#define indcpa_enc BENCH_NS(indcpa_enc)
+#define indcpa_dec BENCH_NS(indcpa_dec)
+#define poly_getnoise_eta1 BENCH_NS(poly_getnoise_eta1)
+#define poly_getnoise_eta2 BENCH_NS(poly_getnoise_eta2)
+#define poly_ntt BENCH_NS(poly_ntt)
+#define poly_invntt_tomont BENCH_NS(poly_invntt_tomont)
+#define poly_compress BENCH_NS(poly_compress)
+#define poly_decompress BENCH_NS(poly_decompress)
+#define poly_tobytes BENCH_NS(poly_tobytes)
+#define poly_frombytes BENCH_NS(poly_frombytes)
+#define poly_tomsg BENCH_NS(poly_tomsg)
+#define poly_frommsg BENCH_NS(poly_frommsg)
+#define polyvec_compress BENCH_NS(polyvec_compress)
+#define polyvec_decompress BENCH_NS(polyvec_decompress)
+#define polyvec_tobytes BENCH_NS(polyvec_tobytes)
+#define polyvec_frombytes BENCH_NS(polyvec_frombytes)
+#endif
+
+#ifndef IMPL_NAME
+#define IMPL_NAME "unknown"
+#endif
+#ifndef BENCH_CFLAGS
+#define BENCH_CFLAGS "unknown"
+#endif
+#ifndef BENCH_COMMIT
+#define BENCH_COMMIT "unknown"
+#endif
+
+/* some vectorized pack routines read or write a few bytes past the end */
+#define SLACK 32
+
+static uint64_t *t;
+static unsigned int ntests = 1000;
+static uint64_t overhead;
+static int csv;
+static int raw;
+static int perf;
+static perf_counts pc;
+
+static uint8_t seed[KYBER_SYMBYTES];
+static uint8_t coins[KYBER_SYMBYTES];
+static uint8_t msg[KYBER_INDCPA_MSGBYTES + SLACK];
+static uint8_t buf[KYBER_POLYVECBYTES + SLACK];
+static uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+static uint8_t sk[CRYPTO_SECRETKEYBYTES];
+static uint8_t ct[CRYPTO_CIPHERTEXTBYTES + SLACK];
+static uint8_t ss[CRYPTO_BYTES];
+static polyvec matrix[KYBER_K];
+static polyvec pv;
+static poly ap, bp, cp, dp;
+
+static int cmp_uint64(const void *a, const void *b) {
+  if(*(uint64_t *)a < *(uint64_t *)b) return -1;
+  if(*(uint64_t *)a > *(uint64_t *)b) return 1;
+  return 0;
+}
+
+/*************************************************
+* Name:        percentile
+*
+* Description: Nearest-rank percentile of a sorted list
+*
+* Arguments:   - const uint64_t *l: pointer to sorted list
+*              - size_t llen:       length of the list
+*              - unsigned int p:    percentile in [1,100]
+**************************************************/
+static uint64_t percentile(const uint64_t *l, size_t llen, unsigned int p) {
+  size_t k = ((size_t)p*llen + 99)/100;
+  return l[k ? k-1 : 0];
+}
+
+/*************************************************
+* Name:        report_env
+*
+* Description: Print the environment header of the raw format, one
+*              "#key value" line per item
+**************************************************/
+static void report_env(void) {
+  char line[256], *model = NULL, *p;
+  FILE *f;
+
+  f = fopen("/proc/cpuinfo", "r");
+  while(f != NULL && fgets(line, sizeof(line), f) != NULL) {
+    if(strncmp(line, "model name", 10) && strncmp(line, "CPU part", 8))
+      continue;
+    if((p = strchr(line, ':')) == NULL)
+      continue;
+    for(model = p+1; *model == ' ' || *model == '\t'; model++);
+    model[strcspn(model, "\n")] = 0;
+    break;
+  }
+  printf("#impl %s\n", IMPL_NAME);
+  printf("#scheme %s\n", CRYPTO_ALGNAME);
+  printf("#cpu %s\n", model != NULL ? model : "unknown");
+  printf("#cc %s\n", __VERSION__);
+  printf("#cflags %s\n", BENCH_CFLAGS);
+  printf("#commit %s\n", BENCH_COMMIT);
+  if(f != NULL)
+    fclose(f);
+}
+
+/*************************************************
+* Name:        report_perf
+*
+* Description: Print the per-call event counts in pc and the IPC;
+*              unavailable events are empty (CSV) or null (JSON)
+**************************************************/
+static void report_perf(void) {
+  unsigned int e;
+  int ipc = pc.valid[PERF_CYCLES] && pc.valid[PERF_INSTRUCTIONS]
+            && pc.count[PERF_CYCLES] > 0;
+
+  if(csv) {
+    for(e=0;e<PERF_NEVENTS;e++) {
+      if(pc.valid[e]) printf(",%.1f", pc.count[e]);
+      else printf(",");
+    }
+    if(ipc) printf(",%.3f", pc.count[PERF_INSTRUCTIONS]/pc.count[PERF_CYCLES]);
+    else printf(",");
+  }
+  else {
+    for(e=0;e<PERF_NEVENTS;e++) {
+      if(pc.valid[e]) printf(",\"%s\":%.1f", perf_event_name[e], pc.count[e]);
+      else printf(",\"%s\":null", perf_event_name[e]);
+    }
+    if(ipc) printf(",\"ipc\":%.3f", pc.count[PERF_INSTRUCTIONS]/pc.count[PERF_CYCLES]);
+    else printf(",\"ipc\":null");
+  }
+}
+
+/*************************************************
+* Name:        report
+*
+* Description: Turn the timestamps in t into call durations and print
+*              their distribution, followed by the event counts in pc
+*              if enabled, as one JSON object or CSV row
+*
+* Arguments:   - const char *name: benchmark name
+**************************************************/
+static void report(const char *name) {
+  unsigned int i;
+  uint64_t d;
+  double mean = 0;
+
+  for(i=0;i<ntests;i++) {
+    d = t[i+1] - t[i];
+    t[i] = d > overhead ? d - overhead : 0;
+    mean += t[i];
+  }
+  mean /= ntests;
+
+  if(raw) {
+    printf("%s %s %s %u", IMPL_NAME, CRYPTO_ALGNAME, name, ntests);
+    for(i=0;i<ntests;i++)
+      printf(" %llu", (unsigned long long)t[i]);
+    printf("\n");
+    return;
+  }
+  qsort(t, ntests, sizeof(uint64_t), cmp_uint64);
+
+  if(csv)
+    printf("%s,%s,%s,%u,%llu,%llu,%llu,%.1f,%llu,%llu,%llu",
+           IMPL_NAME, CRYPTO_ALGNAME, name, ntests,
+           (unsigned long long)t[0],
+           (unsigned long long)percentile(t, ntests, 10),
+           (unsigned long long)percentile(t, ntests, 50),
+           mean,
+           (unsigned long long)percentile(t, ntests, 90),
+           (unsigned long long)percentile(t, ntests, 99),
+           (unsigned long long)t[ntests-1]);
+  else
+    printf("{\"impl\":\"%s\",\"scheme\":\"%s\",\"bench\":\"%s\","
+           "\"n\":%u,\"min\":%llu,\"p10\":%llu,\"median\":%llu,"
+           "\"mean\":%.1f,\"p90\":%llu,\"p99\":%llu,\"max\":%llu",
+           IMPL_NAME, CRYPTO_ALGNAME, name, ntests,
+           (unsigned long long)t[0],
+           (unsigned long long)percentile(t, ntests, 10),
+           (unsigned long long)percentile(t, ntests, 50),
+           mean,
+           (unsigned long long)percentile(t, ntests, 90),
+           (unsigned long long)percentile(t, ntests, 99),
+           (unsigned long long)t[ntests-1]);
+  if(perf)
+    report_perf();
+  printf(csv ? "\n" : "}\n");
+}
+
+/* ntests+1 timestamps delimit ntests calls */
+#define BENCH(name, stmt) do { \
+    unsigned int bench_i_; \
+    for(bench_i_=0;bench_i_<=ntests;bench_i_++) { \
+      t[bench_i_] = cpucycles(); \
+      stmt; \
+    } \
+    if(perf) { \
+      perf_start(); \
+      for(bench_i_=0;bench_i_<ntests;bench_i_++) { \
+        stmt; \
+      } \
+      perf_stop(&pc, ntests); \
+    } \
+    report(name); \
+  } while(0)
+
+/*
+ * Fresh matrix seed for every call of gen_a/gen_at: with a fixed seed the
+ * branch predictor learns the accept pattern of the rejection sampler and
+ * hides its cost. The seed is a counter, so the update inside the timed
+ * region is a few cycles against the tens of thousands of the sampler.
+ */
+static const uint8_t *next_seed(void) {
+  unsigned int i;
+  for(i=0;i<KYBER_SYMBYTES && ++seed[i] == 0;i++);
+  return seed;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr, "usage: %s [-f json|csv|raw] [-n ntests] [-p] [-H]\n", prog);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  int i;
+
+  for(i=1;i<argc;i++) {
+    if(!strcmp(argv[i], "-f") && i+1 < argc) {
+      i++;
+      if(!strcmp(argv[i], "csv")) csv = 1;
+      else if(!strcmp(argv[i], "raw")) raw = 1;
+      else if(strcmp(argv[i], "json")) usage(argv[0]);
+    }
+    else if(!strcmp(argv[i], "-n") && i+1 < argc) {
+      ntests = (unsigned int)strtoul(argv[++i], NULL, 10);
+      if(ntests == 0) usage(argv[0]);
+    }
+    else if(!strcmp(argv[i], "-p"))
+      perf = 1;
+    else if(!strcmp(argv[i], "-H")) {
+      printf("impl,scheme,bench,n,min,p10,median,mean,p90,p99,max");
+      if(perf) {
+        unsigned int e;
+        for(e=0;e<PERF_NEVENTS;e++)
+          printf(",%s", perf_event_name[e]);
+        printf(",ipc");
+      }
+      printf("\n");
+      return 0;
+    }
+    else
+      usage(argv[0]);
+  }
+
+  t = malloc((ntests+1)*sizeof(uint64_t));
+  if(t == NULL)
+    return 1;
+  overhead = cpucycles_overhead();
+  if(perf && perf_open() == 0)
+    fprintf(stderr, "%s: hardware counters not available, "
+                    "event counts are reported as missing\n", argv[0]);
+  if(raw)
+    report_env();
+
+  BENCH("gen_a", gen_matrix(matrix, next_seed(), 0));
+  BENCH("gen_at", gen_matrix(matrix, next_seed(), 1));
+#ifdef poly_getnoise_eta1
+  BENCH("poly_getnoise_eta1", poly_getnoise_eta1(&ap, seed, 0));
+#endif
+#ifdef poly_getnoise_eta2
+  BENCH("poly_getnoise_eta2", poly_getnoise_eta2(&ap, seed, 0));
+#endif
+#ifdef poly_getnoise_eta1_4x
+  BENCH("poly_getnoise_eta1_4x",
+        poly_getnoise_eta1_4x(&ap, &bp, &cp, &dp, seed, 0, 1, 2, 3));
+#endif
+#ifdef poly_getnoise_eta2_4x
+  BENCH("poly_getnoise_eta2_4x",
+        poly_getnoise_eta2_4x(&ap, &bp, &cp, &dp, seed, 0, 1, 2, 3));
+#endif
+  (void)bp; (void)cp; (void)dp;
+
+  BENCH("ntt", poly_ntt(&ap));
+  BENCH("invntt", poly_invntt_tomont(&ap));
+
+  BENCH("poly_compress", poly_compress(buf, &ap));
+  BENCH("poly_decompress", poly_decompress(&ap, buf));
+  BENCH("poly_tobytes", poly_tobytes(buf, &ap));
+  BENCH("poly_frombytes", poly_frombytes(&ap, buf));
+  BENCH("poly_tomsg", poly_tomsg(msg, &ap));
+  BENCH("poly_frommsg", poly_frommsg(&ap, msg));
+  BENCH("polyvec_compress", polyvec_compress(buf, &pv));
+  BENCH("polyvec_decompress", polyvec_decompress(&pv, buf));
+  BENCH("polyvec_tobytes", polyvec_tobytes(buf, &pv));
+  BENCH("polyvec_frombytes", polyvec_frombytes(&pv, buf));
+
+  BENCH("indcpa_keypair", indcpa_keypair(pk, sk));
+  BENCH("indcpa_enc", indcpa_enc(ct, msg, pk, coins));
+  BENCH("indcpa_dec", indcpa_dec(msg, ct, sk));
+
+  BENCH("keypair", crypto_kem_keypair(pk, sk));
+  BENCH("encaps", crypto_kem_enc(ct, ss, pk));
+  BENCH("decaps", crypto_kem_dec(ss, ct, sk));
+
+  perf_close();
+  free(t);
+  return 0;
+}
@@ -0,0 +1,283 @@
+/*
+ * Performance-regression check of two sets of raw benchmark samples.
+ *
+ * Both files are in the raw format of bench -f raw: "#key value"
+ * environment lines followed by one line "impl scheme bench n s_1 .. s_n"
+ * per benchmark with the individual call durations. Files may be the
+ * concatenation of several runs; samples of the same benchmark are pooled.
+ *
+ * For every benchmark present in both files, a one-sided Mann-Whitney U
+ * test (normal approximation with tie correction) checks whether the
+ * current durations are stochastically larger than the baseline ones.
+ * A benchmark regresses if the test is significant at level alpha and
+ * its median grew by more than the threshold; the rank test alone would
+ * flag differences of a fraction of a percent on large samples, the
+ * median alone would flag noise.
+ *
+ * The environment of both files is printed, with a warning if CPU,
+ * compiler or flags differ, since timings are then not comparable.
+ *
+ * usage: compare [-t threshold] [-a alpha] baseline current
+ *   -t  median slowdown in percent that counts as a regression (default 5)
+ *   -a  significance level (default 0.001)
+ *
+ * Exit status: 0 no regression, 1 regression, 2 usage or input error.
+ */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NENV 4
+static const char *env_key[NENV] = { "cpu", "cc", "cflags", "commit" };
+
+typedef struct {
+  char impl[32];
+  char scheme[32];
+  char bench[64];
+  uint64_t *s;
+  size_t n;
+} series;
+
+typedef struct {
+  const char *path;
+  char env[NENV][256];
+  series *v;
+  size_t len, cap;
+} dataset;
+
+typedef struct {
+  uint64_t x;
+  int current;
+} obs;
+
+static int cmp_uint64(const void *a, const void *b) {
+  if(*(uint64_t *)a < *(uint64_t *)b) return -1;
+  if(*(uint64_t *)a > *(uint64_t *)b) return 1;
+  return 0;
+}
+
+static int cmp_obs(const void *a, const void *b) {
+  return cmp_uint64(&((const obs *)a)->x, &((const obs *)b)->x);
+}
+
+static void die(const char *path, const char *msg) {
+  fprintf(stderr, "compare: %s: %s\n", path, msg);
+  exit(2);
+}
+
+static series *find(dataset *d, const char *impl, const char *scheme,
+                    const char *bench)
+{
+  size_t i;
+
+  for(i=0;i<d->len;i++)
+    if(!strcmp(d->v[i].impl, impl) && !strcmp(d->v[i].scheme, scheme)
+       && !strcmp(d->v[i].bench, bench))
+      return &d->v[i];
+  return NULL;
+}
+
+/*************************************************
+* Name:        load
+*
+* Description: Read a file of raw samples; the first value of every
+*              environment key is kept
+*
+* Arguments:   - dataset *d:       pointer to output dataset
+*              - const char *path: file name
+**************************************************/
+static void load(dataset *d, const char *path)
+{
+  char key[64], val[256], impl[32], scheme[32], bench[64];
+  unsigned long long x;
+  unsigned int n, i, k;
+  series *s;
+  FILE *f;
+  int c;
+
+  memset(d, 0, sizeof(*d));
+  d->path = path;
+  if((f = fopen(path, "r")) == NULL)
+    die(path, "cannot open");
+
+  while((c = fgetc(f)) != EOF) {
+    if(c == '\n')
+      continue;
+    if(c == '#') {
+      if(fscanf(f, "%63s", key) != 1 || fgets(val, sizeof(val), f) == NULL)
+        die(path, "malformed environment line");
+      if(strchr(val, '\n') == NULL)  /* overlong, skip the rest */
+        while((c = fgetc(f)) != EOF && c != '\n');
+      val[strcspn(val, "\n")] = 0;
+      for(k=0;k<NENV;k++)
+        if(!strcmp(key, env_key[k]) && d->env[k][0] == 0)
+          snprintf(d->env[k], sizeof(d->env[k]), "%s", val + strspn(val, " "));
+      continue;
+    }
+    ungetc(c, f);
+    if(fscanf(f, "%31s %31s %63s %u", impl, scheme, bench, &n) != 4)
+      die(path, "malformed sample line");
+
+    if((s = find(d, impl, scheme, bench)) == NULL) {
+      if(d->len == d->cap) {
+        d->cap = d->cap ? 2*d->cap : 64;
+        d->v = realloc(d->v, d->cap*sizeof(series));
+        if(d->v == NULL)
+          die(path, "out of memory");
+      }
+      s = &d->v[d->len++];
+      memset(s, 0, sizeof(*s));
+      strcpy(s->impl, impl);
+      strcpy(s->scheme, scheme);
+      strcpy(s->bench, bench);
+    }
+    s->s = realloc(s->s, (s->n + n)*sizeof(uint64_t));
+    if(s->s == NULL)
+      die(path, "out of memory");
+    for(i=0;i<n;i++) {
+      if(fscanf(f, "%llu", &x) != 1)
+        die(path, "truncated sample line");
+      s->s[s->n++] = x;
+    }
+  }
+  fclose(f);
+  if(d->len == 0)
+    die(path, "no samples");
+}
+
+/*************************************************
+* Name:        median
+*
+* Description: Median of a list of samples; sorts the list
+**************************************************/
+static double median(uint64_t *s, size_t n)
+{
+  qsort(s, n, sizeof(uint64_t), cmp_uint64);
+  if(n % 2)
+    return (double)s[n/2];
+  return 0.5*((double)s[n/2-1] + (double)s[n/2]);
+}
+
+/*************************************************
+* Name:        mann_whitney
+*
+* Description: One-sided Mann-Whitney U test of the hypothesis that the
+*              samples in b are stochastically larger than those in a
+*
+* Returns the p-value (normal approximation with continuity and tie
+* correction)
+**************************************************/
+static double mann_whitney(const series *a, const series *b)
+{
+  size_t i, j, n = a->n + b->n;
+  double n1 = (double)a->n, n2 = (double)b->n;
+  double r2 = 0, ties = 0, rank, u, mu, var, z;
+  obs *o;
+
+  o = malloc(n*sizeof(obs));
+  if(o == NULL)
+    die("mann_whitney", "out of memory");
+  for(i=0;i<a->n;i++) {
+    o[i].x = a->s[i];
+    o[i].current = 0;
+  }
+  for(i=0;i<b->n;i++) {
+    o[a->n+i].x = b->s[i];
+    o[a->n+i].current = 1;
+  }
+  qsort(o, n, sizeof(obs), cmp_obs);
+
+  /* ranks 1..n, tied values get the average rank of their run */
+  for(i=0;i<n;i=j) {
+    for(j=i+1;j<n && o[j].x == o[i].x;j++);
+    rank = 0.5*(double)(i + 1 + j);
+    ties += (double)(j-i)*(double)(j-i)*(double)(j-i) - (double)(j-i);
+    for(;i<j;i++)
+      if(o[i].current)
+        r2 += rank;
+  }
+  free(o);
+
+  u = r2 - n2*(n2+1)/2;
+  mu = n1*n2/2;
+  var = n1*n2/12*((double)(n+1) - ties/((double)n*(double)(n-1)));
+  if(var <= 0)
+    return 1;
+  z = (u - mu - 0.5)/sqrt(var);
+  return 0.5*erfc(z/sqrt(2));
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: compare [-t threshold] [-a alpha] baseline current\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  double threshold = 5, alpha = 0.001, mb, mc, change, p;
+  unsigned int k, regressions = 0, improvements = 0, missing = 0;
+  dataset base, cur;
+  const char *verdict;
+  series *b, *c;
+  size_t i;
+  int arg;
+
+  for(arg=1;arg<argc && argv[arg][0] == '-';arg++) {
+    if(!strcmp(argv[arg], "-t") && arg+1 < argc)
+      threshold = atof(argv[++arg]);
+    else if(!strcmp(argv[arg], "-a") && arg+1 < argc)
+      alpha = atof(argv[++arg]);
+    else
+      usage();
+  }
+  if(argc - arg != 2 || threshold < 0 || alpha <= 0 || alpha >= 1)
+    usage();
+  load(&base, argv[arg]);
+  load(&cur, argv[arg+1]);
+
+  for(k=0;k<NENV;k++) {
+    printf("%-8s baseline: %s\n", env_key[k], base.env[k][0] ? base.env[k] : "unknown");
+    printf("%-8s current:  %s\n", "", cur.env[k][0] ? cur.env[k] : "unknown");
+  }
+  for(k=0;k<NENV;k++)
+    if(strcmp(env_key[k], "commit") && strcmp(base.env[k], cur.env[k]))
+      printf("WARNING %s differs, timings are not comparable\n", env_key[k]);
+  printf("threshold: %.1f%%, alpha: %g\n\n", threshold, alpha);
+
+  printf("%-10s %-14s %-22s %10s %10s %8s %9s  %s\n", "impl", "scheme",
+         "bench", "baseline", "current", "change", "p", "verdict");
+  for(i=0;i<base.len;i++) {
+    b = &base.v[i];
+    if((c = find(&cur, b->impl, b->scheme, b->bench)) == NULL) {
+      printf("%-10s %-14s %-22s %10s\n", b->impl, b->scheme, b->bench, "missing");
+      missing++;
+      continue;
+    }
+    p = mann_whitney(b, c);
+    mb = median(b->s, b->n);
+    mc = median(c->s, c->n);
+    change = mb > 0 ? 100*(mc/mb - 1) : 0;
+    verdict = "ok";
+    if(p < alpha && change > threshold) {
+      verdict = "REGRESSION";
+      regressions++;
+    }
+    else if(1 - p < alpha && change < -threshold) {
+      verdict = "faster";
+      improvements++;
+    }
+    printf("%-10s %-14s %-22s %10.0f %10.0f %+7.1f%% %9.2g  %s\n",
+           b->impl, b->scheme, b->bench, mb, mc, change, p, verdict);
+  }
+  for(i=0;i<cur.len;i++) {
+    c = &cur.v[i];
+    if(find(&base, c->impl, c->scheme, c->bench) == NULL)
+      printf("%-10s %-14s %-22s %10s\n", c->impl, c->scheme, c->bench, "new");
+  }
+
+  printf("\n%u regressions, %u improvements, %u missing\n",
+         regressions, improvements, missing);
+  return regressions ? 1 : 0;
+}
@@ -0,0 +1,546 @@
+/*
+ * End-to-end KEM handshakes over local sockets.
+ *
+ * A server and a client run in one process and talk over a Unix-domain
+ * socket or loopback TCP. For every connection count, that many client
+ * threads each run handshakes in a closed loop for a fixed duration
+ * against a pool of server threads:
+ *
+ *   client -> server  1 byte hello
+ *   server -> client  public key (with -e from a fresh crypto_kem_keypair,
+ *                     otherwise the long-term key of the server)
+ *   client -> server  ciphertext of crypto_kem_enc
+ *   server -> client  key confirmation SHA-256(label || shared secret of
+ *                     crypto_kem_dec), which the client checks against
+ *                     its own shared secret; the secret itself is never
+ *                     sent
+ *
+ * By default every handshake opens a new connection, so connection setup
+ * is part of the cost; with -k every client keeps one connection open.
+ * The latency of a handshake is measured on the client from connect (or
+ * from the hello with -k) to the check of the confirmation, and recorded
+ * into log-linear histograms as in load.c. The CPU time per handshake is
+ * taken from the thread CPU clocks, which include the time spent in the
+ * kernel, separately for the server and the client threads.
+ *
+ * randombytes is serialized as in load.c.
+ *
+ * usage: handshake [-c n,n,...] [-s threads] [-x unix|tcp] [-k] [-e]
+ *                  [-d seconds] [-f text|json]
+ *   -c  numbers of concurrent connections (default 1,2,4,... up to the
+ *       number of CPUs)
+ *   -s  server threads (default: as many as connections); with -k at
+ *       least as many as connections, since a server thread serves one
+ *       connection at a time
+ *   -x  transport (default unix)
+ *   -k  keep connections open across handshakes
+ *   -e  ephemeral server keys: one crypto_kem_keypair per handshake
+ *   -d  duration per connection count in seconds (default 2)
+ *   -f  output format (default text)
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <openssl/evp.h>
+
+#ifdef PQCLEAN_NAMESPACE
+#include "api.h"
+#define HS_CAT_(a,b) a##b
+#define HS_CAT(a,b) HS_CAT_(a,b)
+#define HS_NS(s) HS_CAT(PQCLEAN_NAMESPACE,s)
+#define CRYPTO_PUBLICKEYBYTES HS_NS(CRYPTO_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES HS_NS(CRYPTO_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES HS_NS(CRYPTO_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES HS_NS(CRYPTO_BYTES)
+#define CRYPTO_ALGNAME HS_NS(CRYPTO_ALGNAME)
+#define crypto_kem_keypair HS_NS(crypto_kem_keypair)
+#define crypto_kem_enc HS_NS(crypto_kem_enc)
+#define crypto_kem_dec HS_NS(crypto_kem_dec)
+#else
+#include "api.h"
+#endif
+#include "hist.h"
+
+#ifndef IMPL_NAME
+#define IMPL_NAME "unknown"
+#endif
+
+#define MAXTHREADS 256
+#define CONFIRMBYTES 32
+
+/*************************************************
+* Serialized randombytes
+**************************************************/
+static pthread_mutex_t rng_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#ifndef PQCLEAN_NAMESPACE
+int __real_randombytes(unsigned char *x, unsigned long long xlen);
+int __wrap_randombytes(unsigned char *x, unsigned long long xlen);
+
+int __wrap_randombytes(unsigned char *x, unsigned long long xlen)
+{
+  int r;
+
+  pthread_mutex_lock(&rng_lock);
+  r = __real_randombytes(x, xlen);
+  pthread_mutex_unlock(&rng_lock);
+  return r;
+}
+#endif
+
+/*************************************************
+* Sockets
+**************************************************/
+static int use_tcp;
+static struct sockaddr_un addr_un;
+static struct sockaddr_in addr_in;
+
+static uint64_t now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t thread_cpu(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int read_all(int fd, uint8_t *buf, size_t len)
+{
+  ssize_t r;
+
+  while(len > 0) {
+    r = read(fd, buf, len);
+    if(r < 0 && errno == EINTR)
+      continue;
+    if(r <= 0)
+      return -1;
+    buf += r;
+    len -= (size_t)r;
+  }
+  return 0;
+}
+
+static int write_all(int fd, const uint8_t *buf, size_t len)
+{
+  ssize_t r;
+
+  while(len > 0) {
+    r = write(fd, buf, len);
+    if(r < 0 && errno == EINTR)
+      continue;
+    if(r <= 0)
+      return -1;
+    buf += r;
+    len -= (size_t)r;
+  }
+  return 0;
+}
+
+static int listen_socket(void)
+{
+  socklen_t len = sizeof(addr_in);
+  int fd, one = 1;
+
+  if(use_tcp) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0)
+      return -1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr_in, 0, sizeof(addr_in));
+    addr_in.sin_family = AF_INET;
+    addr_in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if(bind(fd, (struct sockaddr *)&addr_in, sizeof(addr_in))
+       || getsockname(fd, (struct sockaddr *)&addr_in, &len))
+      return -1;
+  }
+  else {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0)
+      return -1;
+    memset(&addr_un, 0, sizeof(addr_un));
+    addr_un.sun_family = AF_UNIX;
+    snprintf(addr_un.sun_path, sizeof(addr_un.sun_path),
+             "/tmp/kyber-handshake-%ld.sock", (long)getpid());
+    unlink(addr_un.sun_path);
+    if(bind(fd, (struct sockaddr *)&addr_un, sizeof(addr_un)))
+      return -1;
+  }
+  if(listen(fd, SOMAXCONN))
+    return -1;
+  return fd;
+}
+
+static int connect_socket(void)
+{
+  struct linger lg = { 1, 0 };
+  int fd, one = 1;
+
+  if(use_tcp) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if(fd < 0)
+      return -1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    /* reset on close, so that short connections do not exhaust the
+       local ports in TIME_WAIT */
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+    if(connect(fd, (struct sockaddr *)&addr_in, sizeof(addr_in))) {
+      close(fd);
+      return -1;
+    }
+  }
+  else {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0)
+      return -1;
+    if(connect(fd, (struct sockaddr *)&addr_un, sizeof(addr_un))) {
+      close(fd);
+      return -1;
+    }
+  }
+  return fd;
+}
+
+/* key confirmation tag of a shared secret */
+static void confirm(uint8_t tag[CONFIRMBYTES], const uint8_t ss[CRYPTO_BYTES])
+{
+  static const char label[] = "kyber handshake confirm";
+  uint8_t buf[sizeof(label) - 1 + CRYPTO_BYTES];
+
+  memcpy(buf, label, sizeof(label) - 1);
+  memcpy(buf + sizeof(label) - 1, ss, CRYPTO_BYTES);
+  EVP_Digest(buf, sizeof(buf), tag, NULL, EVP_sha256(), NULL);
+}
+
+/*************************************************
+* Server
+**************************************************/
+typedef struct {
+  pthread_t thread;
+  uint64_t cpu;
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t ss[CRYPTO_BYTES];
+  uint8_t tag[CONFIRMBYTES];
+} server;
+
+static int listen_fd;
+static volatile int stopping;
+static int ephemeral;
+static uint8_t server_pk[CRYPTO_PUBLICKEYBYTES];
+static uint8_t server_sk[CRYPTO_SECRETKEYBYTES];
+
+static void *serve(void *arg)
+{
+  server *s = arg;
+  uint64_t cpu0 = thread_cpu();
+  uint8_t hello;
+  int fd, one = 1;
+
+  if(!ephemeral) {
+    memcpy(s->pk, server_pk, sizeof(s->pk));
+    memcpy(s->sk, server_sk, sizeof(s->sk));
+  }
+  while(1) {
+    fd = accept(listen_fd, NULL, NULL);
+    if(fd < 0) {
+      if(errno == EINTR || errno == ECONNABORTED)
+        continue;
+      break;
+    }
+    if(stopping) {
+      close(fd);
+      break;
+    }
+    if(use_tcp)
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    while(read_all(fd, &hello, 1) == 0) {
+      if(ephemeral)
+        crypto_kem_keypair(s->pk, s->sk);
+      if(write_all(fd, s->pk, sizeof(s->pk))
+         || read_all(fd, s->ct, sizeof(s->ct)))
+        break;
+      crypto_kem_dec(s->ss, s->ct, s->sk);
+      confirm(s->tag, s->ss);
+      if(write_all(fd, s->tag, sizeof(s->tag)))
+        break;
+    }
+    close(fd);
+  }
+  s->cpu = thread_cpu() - cpu0;
+  return NULL;
+}
+
+/*************************************************
+* Client
+**************************************************/
+typedef struct {
+  pthread_t thread;
+  histogram hist;
+  uint64_t cpu;
+  uint64_t errors;
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t ss[CRYPTO_BYTES];
+  uint8_t tag[CONFIRMBYTES];
+  uint8_t tag_server[CONFIRMBYTES];
+} client;
+
+static int keepalive;
+/* written by main between the two barriers of a run, read-only after */
+static uint64_t t_start, t_stop;
+static pthread_barrier_t barrier;
+
+/* one handshake on fd; returns 0 if the server confirms the key */
+static int handshake(client *c, int fd)
+{
+  const uint8_t hello = 1;
+
+  if(write_all(fd, &hello, 1) || read_all(fd, c->pk, sizeof(c->pk)))
+    return -1;
+  crypto_kem_enc(c->ct, c->ss, c->pk);
+  if(write_all(fd, c->ct, sizeof(c->ct))
+     || read_all(fd, c->tag_server, sizeof(c->tag_server)))
+    return -1;
+  confirm(c->tag, c->ss);
+  return memcmp(c->tag, c->tag_server, sizeof(c->tag)) ? -1 : 0;
+}
+
+static void *run_client(void *arg)
+{
+  client *c = arg;
+  uint64_t t0, cpu0;
+  int fd = -1;
+
+  memset(&c->hist, 0, sizeof(c->hist));
+  c->errors = 0;
+  if(keepalive)
+    fd = connect_socket();
+
+  /* t_start and t_stop are set between the two barriers and only read
+   * after the second one */
+  pthread_barrier_wait(&barrier);
+  pthread_barrier_wait(&barrier);
+  cpu0 = thread_cpu();
+  while((t0 = now()) < t_stop) {
+    if(!keepalive)
+      fd = connect_socket();
+    if(fd < 0 || handshake(c, fd)) {
+      c->errors++;
+      if(fd >= 0)
+        close(fd);
+      fd = keepalive ? connect_socket() : -1;
+      continue;
+    }
+    if(!keepalive) {
+      close(fd);
+      fd = -1;
+    }
+    hist_add(&c->hist, now() - t0);
+  }
+  c->cpu = thread_cpu() - cpu0;
+  if(fd >= 0)
+    close(fd);
+  return NULL;
+}
+
+/*************************************************
+* Driver
+**************************************************/
+static void usage(const char *prog)
+{
+  fprintf(stderr, "usage: %s [-c n,n,...] [-s threads] [-x unix|tcp] [-k] [-e] "
+                  "[-d seconds] [-f text|json]\n", prog);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int i, j, ncounts = 0, counts[32], nconns, nservers, sthreads = 0;
+  int json = 0, fd;
+  double duration = 2, elapsed, cpu_server, cpu_client;
+  long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  uint64_t errors;
+  server *s;
+  client *c;
+  histogram *total;
+  char *p;
+
+  for(i=1;i<(unsigned int)argc;i++) {
+    if(!strcmp(argv[i], "-c") && i+1 < (unsigned int)argc) {
+      for(p=argv[++i];*p && ncounts<32;) {
+        counts[ncounts] = (unsigned int)strtoul(p, &p, 10);
+        if(counts[ncounts] == 0 || counts[ncounts] > MAXTHREADS)
+          usage(argv[0]);
+        ncounts++;
+        if(*p == ',') p++;
+        else if(*p) usage(argv[0]);
+      }
+    }
+    else if(!strcmp(argv[i], "-s") && i+1 < (unsigned int)argc) {
+      sthreads = (unsigned int)strtoul(argv[++i], NULL, 10);
+      if(sthreads == 0 || sthreads > MAXTHREADS)
+        usage(argv[0]);
+    }
+    else if(!strcmp(argv[i], "-x") && i+1 < (unsigned int)argc) {
+      i++;
+      if(!strcmp(argv[i], "tcp")) use_tcp = 1;
+      else if(strcmp(argv[i], "unix")) usage(argv[0]);
+    }
+    else if(!strcmp(argv[i], "-k"))
+      keepalive = 1;
+    else if(!strcmp(argv[i], "-e"))
+      ephemeral = 1;
+    else if(!strcmp(argv[i], "-d") && i+1 < (unsigned int)argc)
+      duration = atof(argv[++i]);
+    else if(!strcmp(argv[i], "-f") && i+1 < (unsigned int)argc) {
+      i++;
+      if(!strcmp(argv[i], "json")) json = 1;
+      else if(strcmp(argv[i], "text")) usage(argv[0]);
+    }
+    else
+      usage(argv[0]);
+  }
+  if(duration <= 0)
+    usage(argv[0]);
+  if(ncounts == 0)
+    for(j=1;j<=(unsigned int)(ncpus > 0 ? ncpus : 1) && ncounts<32;j*=2)
+      counts[ncounts++] = j;
+  for(i=0;i<ncounts;i++)
+    if(keepalive && sthreads && sthreads < counts[i]) {
+      fprintf(stderr, "%s: -k needs at least as many server threads "
+                      "as connections\n", argv[0]);
+      return 1;
+    }
+
+  signal(SIGPIPE, SIG_IGN);
+  s = malloc(MAXTHREADS*sizeof(server));
+  c = malloc(MAXTHREADS*sizeof(client));
+  total = malloc(sizeof(histogram));
+  if(s == NULL || c == NULL || total == NULL)
+    return 1;
+  crypto_kem_keypair(server_pk, server_sk);
+
+  if(!json)
+    printf("%-10s %-14s %-4s %-9s %5s %7s %9s %10s %10s %10s %10s %10s %10s %9s %9s\n",
+           "impl", "scheme", "xprt", "mode", "conns", "servers", "hs",
+           "hs/s", "p50[ns]", "p90[ns]", "p99[ns]", "p99.9[ns]", "max[ns]",
+           "srv[us]", "cli[us]");
+
+  for(i=0;i<ncounts;i++) {
+    nconns = counts[i];
+    nservers = sthreads ? sthreads : nconns;
+    if((listen_fd = listen_socket()) < 0) {
+      fprintf(stderr, "%s: cannot listen: %s\n", argv[0], strerror(errno));
+      return 1;
+    }
+    stopping = 0;
+    for(j=0;j<nservers;j++) {
+      if(pthread_create(&s[j].thread, NULL, serve, &s[j])) {
+        fprintf(stderr, "%s: cannot create thread\n", argv[0]);
+        return 1;
+      }
+    }
+
+    pthread_barrier_init(&barrier, NULL, nconns + 1);
+    for(j=0;j<nconns;j++) {
+      if(pthread_create(&c[j].thread, NULL, run_client, &c[j])) {
+        fprintf(stderr, "%s: cannot create thread\n", argv[0]);
+        return 1;
+      }
+    }
+    /* the clients connect (with -k) before the first barrier and start
+     * measuring after the second one */
+    pthread_barrier_wait(&barrier);
+    t_start = now();
+    t_stop = t_start + (uint64_t)(duration*1e9);
+    pthread_barrier_wait(&barrier);
+    for(j=0;j<nconns;j++)
+      pthread_join(c[j].thread, NULL);
+    elapsed = (now() - t_start)/1e9;
+    pthread_barrier_destroy(&barrier);
+
+    /* wake every server thread blocked in accept */
+    stopping = 1;
+    for(j=0;j<nservers;j++)
+      if((fd = connect_socket()) >= 0)
+        close(fd);
+    for(j=0;j<nservers;j++)
+      pthread_join(s[j].thread, NULL);
+    close(listen_fd);
+    if(!use_tcp)
+      unlink(addr_un.sun_path);
+
+    memset(total, 0, sizeof(*total));
+    errors = 0;
+    cpu_server = cpu_client = 0;
+    for(j=0;j<nconns;j++) {
+      hist_merge(total, &c[j].hist);
+      errors += c[j].errors;
+      cpu_client += c[j].cpu;
+    }
+    for(j=0;j<nservers;j++)
+      cpu_server += s[j].cpu;
+    if(total->n) {
+      cpu_server /= 1e3*total->n;
+      cpu_client /= 1e3*total->n;
+    }
+    if(errors)
+      fprintf(stderr, "%s: %llu failed handshakes\n", argv[0],
+              (unsigned long long)errors);
+
+    if(json)
+      printf("{\"impl\":\"%s\",\"scheme\":\"%s\",\"transport\":\"%s\","
+             "\"keepalive\":%s,\"ephemeral\":%s,\"connections\":%u,"
+             "\"servers\":%u,\"duration\":%.3f,\"handshakes\":%llu,"
+             "\"errors\":%llu,\"throughput\":%.1f,"
+             "\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,"
+             "\"max\":%llu,\"cpu_server_us\":%.2f,\"cpu_client_us\":%.2f}\n",
+             IMPL_NAME, CRYPTO_ALGNAME, use_tcp ? "tcp" : "unix",
+             keepalive ? "true" : "false", ephemeral ? "true" : "false",
+             nconns, nservers, elapsed, (unsigned long long)total->n,
+             (unsigned long long)errors, total->n/elapsed,
+             (unsigned long long)hist_quantile(total, 500000),
+             (unsigned long long)hist_quantile(total, 900000),
+             (unsigned long long)hist_quantile(total, 990000),
+             (unsigned long long)hist_quantile(total, 999000),
+             (unsigned long long)total->max, cpu_server, cpu_client);
+    else
+      printf("%-10s %-14s %-4s %-9s %5u %7u %9llu %10.1f %10llu %10llu %10llu %10llu %10llu %9.2f %9.2f\n",
+             IMPL_NAME, CRYPTO_ALGNAME, use_tcp ? "tcp" : "unix",
+             keepalive ? (ephemeral ? "keep,eph" : "keep")
+                       : (ephemeral ? "conn,eph" : "conn"),
+             nconns, nservers, (unsigned long long)total->n, total->n/elapsed,
+             (unsigned long long)hist_quantile(total, 500000),
+             (unsigned long long)hist_quantile(total, 900000),
+             (unsigned long long)hist_quantile(total, 990000),
+             (unsigned long long)hist_quantile(total, 999000),
+             (unsigned long long)total->max, cpu_server, cpu_client);
+    fflush(stdout);
+  }
+
+  free(s);
+  free(c);
+  free(total);
+  return 0;
+}
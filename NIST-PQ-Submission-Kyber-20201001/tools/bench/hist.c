@@ -0,0 +1,61 @@
+#include <stdint.h>
+#include "hist.h"
+
+static unsigned int hist_index(uint64_t v)
+{
+  unsigned int m, shift;
+
+  if(v < 2*HIST_SUB)
+    return (unsigned int)v;
+  m = 63 - (unsigned int)__builtin_clzll(v);
+  shift = m - HIST_SUBBITS;
+  return 2*HIST_SUB + (shift-1)*HIST_SUB + (unsigned int)((v >> shift) - HIST_SUB);
+}
+
+/* upper end of bucket i, so that reported percentiles never understate */
+static uint64_t hist_value(unsigned int i)
+{
+  unsigned int shift;
+
+  if(i < 2*HIST_SUB)
+    return i;
+  shift = (i - 2*HIST_SUB)/HIST_SUB + 1;
+  return ((uint64_t)(HIST_SUB + (i - 2*HIST_SUB)%HIST_SUB + 1) << shift) - 1;
+}
+
+void hist_add(histogram *h, uint64_t v)
+{
+  h->count[hist_index(v)]++;
+  h->n++;
+  if(v > h->max)
+    h->max = v;
+}
+
+void hist_merge(histogram *r, const histogram *h)
+{
+  unsigned int i;
+
+  for(i=0;i<HIST_NBUCKETS;i++)
+    r->count[i] += h->count[i];
+  r->n += h->n;
+  if(h->max > r->max)
+    r->max = h->max;
+}
+
+uint64_t hist_quantile(const histogram *h, uint64_t q)
+{
+  unsigned int i;
+  uint64_t rank, seen = 0;
+
+  if(h->n == 0)
+    return 0;
+  rank = (h->n*q + 999999)/1000000;
+  if(rank == 0)
+    rank = 1;
+  for(i=0;i<HIST_NBUCKETS;i++) {
+    seen += h->count[i];
+    if(seen >= rank)
+      return hist_value(i) < h->max ? hist_value(i) : h->max;
+  }
+  return h->max;
+}
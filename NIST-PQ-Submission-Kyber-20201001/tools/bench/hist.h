@@ -0,0 +1,27 @@
+#ifndef HIST_H
+#define HIST_H
+
+#include <stdint.h>
+
+/*
+ * Log-linear histogram of the latency tools (load.c, handshake.c).
+ * Values below 2*HIST_SUB are counted exactly; above, a value with most
+ * significant bit m falls into one of HIST_SUB buckets of width
+ * 2^(m-HIST_SUBBITS), so the relative error is below 1/HIST_SUB.
+ * A zeroed histogram is empty.
+ */
+#define HIST_SUBBITS 6
+#define HIST_SUB (1 << HIST_SUBBITS)
+#define HIST_NBUCKETS (2*HIST_SUB + (64-HIST_SUBBITS-1)*HIST_SUB)
+
+typedef struct {
+  uint64_t count[HIST_NBUCKETS];
+  uint64_t n, max;
+} histogram;
+
+void hist_add(histogram *h, uint64_t v);
+void hist_merge(histogram *r, const histogram *h);
+/* q in parts per million */
+uint64_t hist_quantile(const histogram *h, uint64_t q);
+
+#endif
@@ -0,0 +1,310 @@
+/*
+ * Latency of keypair, encaps or decaps under concurrent load.
+ *
+ * For every thread count, N threads pinned to CPUs 0..N-1 (modulo the
+ * number of CPUs) run the operation for a fixed duration, either in a
+ * closed loop (every thread starts the next call as soon as the previous
+ * one returns) or at a target aggregate rate (open loop). In rate mode
+ * the latency is measured from the scheduled start of a call, so a thread
+ * that falls behind its schedule accounts the queueing delay instead of
+ * hiding it (no coordinated omission).
+ *
+ * Latencies are recorded in nanoseconds into log-linear histograms with
+ * 64 sub-buckets per power of two (relative error below 1/64), one per
+ * thread and merged at the end.
+ *
+ * The ref-style implementations draw their randomness from one global
+ * AES-CTR DRBG in rng.c which is not thread-safe. randombytes is
+ * therefore wrapped at link time (-Wl,--wrap=randombytes) and serialized
+ * with a mutex; the time spent waiting for it is part of the latency and
+ * shows up as a scaling cliff. With -u the lock is skipped, which is a
+ * data race on the DRBG state and only meant to isolate the lock cost.
+ *
+ * usage: load [-o keypair|enc|dec] [-t n,n,...] [-d seconds] [-r rate]
+ *             [-u] [-f text|json]
+ *   -o  operation (default dec)
+ *   -t  thread counts (default 1,2,4,... up to the number of CPUs)
+ *   -d  duration per thread count in seconds (default 2)
+ *   -r  aggregate target rate in operations per second (default 0: closed
+ *       loop)
+ *   -u  do not serialize randombytes
+ *   -f  output format (default text)
+ */
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef PQCLEAN_NAMESPACE
+#include "api.h"
+#define LOAD_CAT_(a,b) a##b
+#define LOAD_CAT(a,b) LOAD_CAT_(a,b)
+#define LOAD_NS(s) LOAD_CAT(PQCLEAN_NAMESPACE,s)
+#define CRYPTO_PUBLICKEYBYTES LOAD_NS(CRYPTO_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES LOAD_NS(CRYPTO_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES LOAD_NS(CRYPTO_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES LOAD_NS(CRYPTO_BYTES)
+#define CRYPTO_ALGNAME LOAD_NS(CRYPTO_ALGNAME)
+#define crypto_kem_keypair LOAD_NS(crypto_kem_keypair)
+#define crypto_kem_enc LOAD_NS(crypto_kem_enc)
+#define crypto_kem_dec LOAD_NS(crypto_kem_dec)
+#else
+#include "api.h"
+#endif
+#include "hist.h"
+
+#ifndef IMPL_NAME
+#define IMPL_NAME "unknown"
+#endif
+
+#define MAXTHREADS 256
+
+/*************************************************
+* Serialized randombytes
+**************************************************/
+static int rng_unlocked;
+static pthread_mutex_t rng_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#ifndef PQCLEAN_NAMESPACE
+int __real_randombytes(unsigned char *x, unsigned long long xlen);
+int __wrap_randombytes(unsigned char *x, unsigned long long xlen);
+
+int __wrap_randombytes(unsigned char *x, unsigned long long xlen)
+{
+  int r;
+
+  if(rng_unlocked)
+    return __real_randombytes(x, xlen);
+  pthread_mutex_lock(&rng_lock);
+  r = __real_randombytes(x, xlen);
+  pthread_mutex_unlock(&rng_lock);
+  return r;
+}
+#endif
+
+/*************************************************
+* Worker threads
+**************************************************/
+enum op { OP_KEYPAIR, OP_ENC, OP_DEC };
+static const char *op_name[] = { "keypair", "enc", "dec" };
+
+typedef struct {
+  pthread_t thread;
+  unsigned int id;
+  histogram hist;
+  uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+  uint8_t sk[CRYPTO_SECRETKEYBYTES];
+  uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+  uint8_t ss[CRYPTO_BYTES];
+} worker;
+
+static enum op op = OP_DEC;
+static double rate;
+static unsigned int nthreads;
+/* written by main between the two barriers of a run, read-only after */
+static uint64_t t_start, t_stop;
+static pthread_barrier_t barrier;
+
+static uint64_t now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void sleep_until(uint64_t t)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)(t / 1000000000ULL);
+  ts.tv_nsec = (long)(t % 1000000000ULL);
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+    ;
+}
+
+static void run_op(worker *w)
+{
+  switch(op) {
+    case OP_KEYPAIR:
+      crypto_kem_keypair(w->pk, w->sk);
+      break;
+    case OP_ENC:
+      crypto_kem_enc(w->ct, w->ss, w->pk);
+      break;
+    case OP_DEC:
+      crypto_kem_dec(w->ss, w->ct, w->sk);
+      break;
+  }
+}
+
+static void *work(void *arg)
+{
+  worker *w = arg;
+  uint64_t t0, t1, interval = 0, k = 0;
+  cpu_set_t cpus;
+  long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+  CPU_ZERO(&cpus);
+  CPU_SET(w->id % (ncpus > 0 ? (unsigned long)ncpus : 1UL), &cpus);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+  crypto_kem_keypair(w->pk, w->sk);
+  crypto_kem_enc(w->ct, w->ss, w->pk);
+  memset(&w->hist, 0, sizeof(w->hist));
+  if(rate > 0)
+    interval = (uint64_t)(1e9 * nthreads / rate);
+
+  /* keys are ready; t_start and t_stop are set between the two barriers
+   * and only read after the second one */
+  pthread_barrier_wait(&barrier);
+  pthread_barrier_wait(&barrier);
+  /* stagger the open-loop schedules of the threads */
+  t1 = t_start + interval*w->id/nthreads;
+  while(1) {
+    if(interval) {
+      t0 = t1 + k++*interval;
+      if(t0 >= t_stop)
+        break;
+      sleep_until(t0);
+    }
+    else {
+      t0 = now();
+      if(t0 >= t_stop)
+        break;
+    }
+    run_op(w);
+    hist_add(&w->hist, now() - t0);
+  }
+  return NULL;
+}
+
+/*************************************************
+* Driver
+**************************************************/
+static void usage(const char *prog)
+{
+  fprintf(stderr, "usage: %s [-o keypair|enc|dec] [-t n,n,...] "
+                  "[-d seconds] [-r rate] [-u] [-f text|json]\n", prog);
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int i, j, ncounts = 0, counts[32];
+  int json = 0;
+  double duration = 2;
+  long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  worker *w;
+  histogram *total;
+  char *p;
+
+  for(i=1;i<(unsigned int)argc;i++) {
+    if(!strcmp(argv[i], "-o") && i+1 < (unsigned int)argc) {
+      i++;
+      for(j=0;j<3;j++)
+        if(!strcmp(argv[i], op_name[j]))
+          break;
+      if(j == 3) usage(argv[0]);
+      op = (enum op)j;
+    }
+    else if(!strcmp(argv[i], "-t") && i+1 < (unsigned int)argc) {
+      for(p=argv[++i];*p && ncounts<32;) {
+        counts[ncounts] = (unsigned int)strtoul(p, &p, 10);
+        if(counts[ncounts] == 0 || counts[ncounts] > MAXTHREADS)
+          usage(argv[0]);
+        ncounts++;
+        if(*p == ',') p++;
+        else if(*p) usage(argv[0]);
+      }
+    }
+    else if(!strcmp(argv[i], "-d") && i+1 < (unsigned int)argc)
+      duration = atof(argv[++i]);
+    else if(!strcmp(argv[i], "-r") && i+1 < (unsigned int)argc)
+      rate = atof(argv[++i]);
+    else if(!strcmp(argv[i], "-u"))
+      rng_unlocked = 1;
+    else if(!strcmp(argv[i], "-f") && i+1 < (unsigned int)argc) {
+      i++;
+      if(!strcmp(argv[i], "json")) json = 1;
+      else if(strcmp(argv[i], "text")) usage(argv[0]);
+    }
+    else
+      usage(argv[0]);
+  }
+  if(duration <= 0 || rate < 0)
+    usage(argv[0]);
+  if(ncounts == 0)
+    for(j=1;j<=(unsigned int)(ncpus > 0 ? ncpus : 1) && ncounts<32;j*=2)
+      counts[ncounts++] = j;
+
+  w = malloc(MAXTHREADS*sizeof(worker));
+  total = malloc(sizeof(histogram));
+  if(w == NULL || total == NULL)
+    return 1;
+
+  if(!json)
+    printf("%-10s %-14s %-8s %7s %9s %12s %10s %10s %10s %10s %10s\n",
+           "impl", "scheme", "op", "threads", "ops", "ops/s",
+           "p50[ns]", "p90[ns]", "p99[ns]", "p99.9[ns]", "max[ns]");
+
+  for(i=0;i<ncounts;i++) {
+    nthreads = counts[i];
+    pthread_barrier_init(&barrier, NULL, nthreads + 1);
+    for(j=0;j<nthreads;j++) {
+      w[j].id = j;
+      if(pthread_create(&w[j].thread, NULL, work, &w[j])) {
+        fprintf(stderr, "%s: cannot create thread\n", argv[0]);
+        return 1;
+      }
+    }
+    /* the workers generate their keys before the first barrier and
+     * start measuring after the second one */
+    pthread_barrier_wait(&barrier);
+    t_start = now() + 1000000;
+    t_stop = t_start + (uint64_t)(duration*1e9);
+    pthread_barrier_wait(&barrier);
+    for(j=0;j<nthreads;j++)
+      pthread_join(w[j].thread, NULL);
+    pthread_barrier_destroy(&barrier);
+
+    memset(total, 0, sizeof(*total));
+    for(j=0;j<nthreads;j++)
+      hist_merge(total, &w[j].hist);
+
+    if(json)
+      printf("{\"impl\":\"%s\",\"scheme\":\"%s\",\"op\":\"%s\","
+             "\"threads\":%u,\"rate\":%.1f,\"rng_locked\":%s,"
+             "\"duration\":%.3f,\"ops\":%llu,\"throughput\":%.1f,"
+             "\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,"
+             "\"max\":%llu}\n",
+             IMPL_NAME, CRYPTO_ALGNAME, op_name[op], nthreads, rate,
+             rng_unlocked ? "false" : "true", duration,
+             (unsigned long long)total->n, total->n/duration,
+             (unsigned long long)hist_quantile(total, 500000),
+             (unsigned long long)hist_quantile(total, 900000),
+             (unsigned long long)hist_quantile(total, 990000),
+             (unsigned long long)hist_quantile(total, 999000),
+             (unsigned long long)total->max);
+    else
+      printf("%-10s %-14s %-8s %7u %9llu %12.1f %10llu %10llu %10llu %10llu %10llu\n",
+             IMPL_NAME, CRYPTO_ALGNAME, op_name[op], nthreads,
+             (unsigned long long)total->n, total->n/duration,
+             (unsigned long long)hist_quantile(total, 500000),
+             (unsigned long long)hist_quantile(total, 900000),
+             (unsigned long long)hist_quantile(total, 990000),
+             (unsigned long long)hist_quantile(total, 999000),
+             (unsigned long long)total->max);
+    fflush(stdout);
+  }
+
+  free(w);
+  free(total);
+  return 0;
+}
@@ -0,0 +1,168 @@
+#define _DEFAULT_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "perf.h"
+
+const char *const perf_event_name[PERF_NEVENTS] = {
+  "cycles",
+  "instructions",
+  "l1d_misses",
+  "llc_misses",
+  "branch_misses",
+};
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} events[PERF_NEVENTS] = {
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static int fd[PERF_NEVENTS] = { -1, -1, -1, -1, -1 };
+/* position of every opened event in the group read-out, -1 if absent */
+static int slot[PERF_NEVENTS];
+static unsigned int nslots;
+
+static int open_event(unsigned int e, int group)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = events[e].type;
+  attr.config = events[e].config;
+  attr.disabled = (group == -1);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP
+                   | PERF_FORMAT_TOTAL_TIME_ENABLED
+                   | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+/*************************************************
+* Name:        perf_open
+*
+* Description: Open the counter group for the calling thread
+*
+* Returns the number of events that could be opened
+**************************************************/
+int perf_open(void)
+{
+  unsigned int e;
+
+  nslots = 0;
+  for(e=0;e<PERF_NEVENTS;e++)
+    slot[e] = -1;
+
+  fd[PERF_CYCLES] = open_event(PERF_CYCLES, -1);
+  if(fd[PERF_CYCLES] < 0)
+    return 0;
+  slot[PERF_CYCLES] = nslots++;
+
+  for(e=PERF_CYCLES+1;e<PERF_NEVENTS;e++) {
+    fd[e] = open_event(e, fd[PERF_CYCLES]);
+    if(fd[e] >= 0)
+      slot[e] = nslots++;
+  }
+  return (int)nslots;
+}
+
+/*************************************************
+* Name:        perf_start
+*
+* Description: Reset and enable all counters of the group
+**************************************************/
+void perf_start(void)
+{
+  if(fd[PERF_CYCLES] < 0)
+    return;
+  ioctl(fd[PERF_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fd[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/*************************************************
+* Name:        perf_stop
+*
+* Description: Disable the group and store the counts per call, scaled
+*              up if the kernel had to multiplex the group
+*
+* Arguments:   - perf_counts *c:       pointer to output counts
+*              - unsigned int ncalls:  number of calls since perf_start
+**************************************************/
+void perf_stop(perf_counts *c, unsigned int ncalls)
+{
+  unsigned int e;
+  uint64_t buf[3 + PERF_NEVENTS];
+  double scale;
+
+  memset(c, 0, sizeof(*c));
+  if(fd[PERF_CYCLES] < 0)
+    return;
+  ioctl(fd[PERF_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  if(read(fd[PERF_CYCLES], buf, sizeof(buf)) < (ssize_t)(3*sizeof(uint64_t))
+     || buf[0] != nslots || buf[2] == 0)
+    return;
+
+  /* buf: nr, time_enabled, time_running, values */
+  scale = (double)buf[1] / (double)buf[2] / ncalls;
+  for(e=0;e<PERF_NEVENTS;e++) {
+    if(slot[e] < 0)
+      continue;
+    c->valid[e] = 1;
+    c->count[e] = (double)buf[3 + slot[e]] * scale;
+  }
+}
+
+/*************************************************
+* Name:        perf_close
+*
+* Description: Close all counters
+**************************************************/
+void perf_close(void)
+{
+  unsigned int e;
+
+  for(e=0;e<PERF_NEVENTS;e++) {
+    if(fd[e] >= 0)
+      close(fd[e]);
+    fd[e] = -1;
+  }
+}
+
+#else
+
+int perf_open(void)
+{
+  return 0;
+}
+
+void perf_start(void)
+{
+}
+
+void perf_stop(perf_counts *c, unsigned int ncalls)
+{
+  (void)ncalls;
+  memset(c, 0, sizeof(*c));
+}
+
+void perf_close(void)
+{
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+/*
+ * Hardware event counters through Linux perf_event_open, opened as one
+ * group so that all events count over exactly the same interval.
+ * Events the kernel or the CPU refuses are left out of the group; if
+ * not even the cycle counter can be opened (no PMU, perf_event_paranoid,
+ * not Linux), perf_open returns 0 and the counters stay unavailable.
+ */
+enum perf_event {
+  PERF_CYCLES,
+  PERF_INSTRUCTIONS,
+  PERF_L1D_MISSES,
+  PERF_LLC_MISSES,
+  PERF_BRANCH_MISSES,
+  PERF_NEVENTS
+};
+
+typedef struct {
+  int valid[PERF_NEVENTS];
+  double count[PERF_NEVENTS];
+} perf_counts;
+
+extern const char *const perf_event_name[PERF_NEVENTS];
+
+int perf_open(void);
+void perf_start(void);
+void perf_stop(perf_counts *c, unsigned int ncalls);
+void perf_close(void);
+
+#endif
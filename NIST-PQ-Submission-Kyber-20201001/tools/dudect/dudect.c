@@ -0,0 +1,405 @@
+/*
+ * Timing-leakage test (dudect) shared by all implementations.
+ *
+ * For every target the harness measures single calls on two classes of
+ * secret input, class 0 fixed and class 1 fresh random, interleaved in
+ * random order, and runs Welch's t-test on the two cycle distributions.
+ * As in dudect (Reparaz, Balasch, Verbauwhede, "Dude, is my code
+ * constant time?"), the test is also run on the measurements below a
+ * set of percentiles of the first batch, which removes the long tail of
+ * interrupts and other noise; the largest |t| of all these tests is
+ * reported. |t| above T_LEAK is evidence of a timing difference between
+ * the classes; below, the target passed with the given number of
+ * measurements, which is no proof of constant time.
+ *
+ * Targets:
+ *   decaps         valid ciphertext vs random ciphertext (implicit
+ *                  rejection path) under a fixed secret key
+ *   verify         equal vs random second input
+ *   cmov           condition 0 vs 1
+ *   poly_tomsg     fixed vs random polynomial
+ *   cbd_eta1       fixed vs random noise input bytes
+ *   cbd_eta1_keccak, cbd_eta2_keccak
+ *                  fixed vs random Keccak state, where the implementation
+ *                  samples straight from the SHAKE256 state
+ *   poly_compress  fixed vs random polynomial (division by q)
+ *
+ * usage: dudect [-n measurements] [-s seed] [-t target] [-f text|json]
+ * The exit status is 1 if any target shows leakage.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "api.h"
+#include "params.h"
+#include "poly.h"
+#include "cbd.h"
+#include "verify.h"
+#include "cpucycles.h"
+
+#ifdef PQCLEAN_NAMESPACE
+/* PQClean layout: every exported name carries the scheme prefix */
+#define DUDECT_CAT_(a,b) a##b
+#define DUDECT_CAT(a,b) DUDECT_CAT_(a,b)
+#define DUDECT_NS(s) DUDECT_CAT(PQCLEAN_NAMESPACE,s)
+#define CRYPTO_PUBLICKEYBYTES DUDECT_NS(CRYPTO_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES DUDECT_NS(CRYPTO_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES DUDECT_NS(CRYPTO_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES DUDECT_NS(CRYPTO_BYTES)
+#define CRYPTO_ALGNAME DUDECT_NS(CRYPTO_ALGNAME)
+#define crypto_kem_keypair DUDECT_NS(crypto_kem_keypair)
+#define crypto_kem_enc DUDECT_NS(crypto_kem_enc)
+#define crypto_kem_dec DUDECT_NS(crypto_kem_dec)
+#define verify DUDECT_NS(verify)
+#define cmov DUDECT_NS(cmov)
+#define poly_tomsg DUDECT_NS(poly_tomsg)
+#define cbd_eta1 DUDECT_NS(cbd_eta1)
+#define poly_compress DUDECT_NS(poly_compress)
+#endif
+
+#ifndef IMPL_NAME
+#define IMPL_NAME "unknown"
+#endif
+
+/* measurements per batch; inputs of a batch are prepared before timing */
+#define NBATCH 1000
+/* percentiles of the first batch used for cropping */
+#define NCROPS 10
+#define T_LEAK 4.5
+/* some vectorized routines read or write a few bytes past the end */
+#define SLACK 32
+#define SLOTBYTES ((CRYPTO_CIPHERTEXTBYTES + SLACK + 63)/64*64)
+
+typedef struct {
+  double n[2];
+  double mean[2];
+  double m2[2];
+} ttest;
+
+typedef struct {
+  const char *name;
+  void (*prepare)(unsigned int slot, int cls);
+  void (*run)(unsigned int slot);
+} target;
+
+static uint8_t slots[NBATCH][SLOTBYTES] __attribute__((aligned(64)));
+static poly polys[NBATCH];
+static int classes[NBATCH];
+static uint64_t cycles[NBATCH];
+
+static uint8_t pk[CRYPTO_PUBLICKEYBYTES];
+static uint8_t sk[CRYPTO_SECRETKEYBYTES];
+static uint8_t ct[CRYPTO_CIPHERTEXTBYTES];
+static uint8_t ss[CRYPTO_BYTES];
+static uint8_t out[SLOTBYTES] __attribute__((aligned(64)));
+static uint8_t fixed[SLOTBYTES] __attribute__((aligned(64)));
+static poly fixed_poly;
+static poly out_poly;
+#ifdef cbd_eta1_keccak
+static keccak_state states[NBATCH];
+static keccak_state fixed_state;
+#endif
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+/* xorshift64*: input generation only, not cryptographic */
+static uint64_t rand64(void)
+{
+  rng_state ^= rng_state >> 12;
+  rng_state ^= rng_state << 25;
+  rng_state ^= rng_state >> 27;
+  return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static void rand_bytes(uint8_t *r, size_t len)
+{
+  size_t i;
+  uint64_t x = 0;
+
+  for(i=0;i<len;i++) {
+    if(i%8 == 0)
+      x = rand64();
+    r[i] = (uint8_t)x;
+    x >>= 8;
+  }
+}
+
+static void rand_poly(poly *r)
+{
+  unsigned int i;
+
+  for(i=0;i<KYBER_N;i++)
+    r->coeffs[i] = (int16_t)(rand64() % KYBER_Q);
+}
+
+/*************************************************
+* Targets
+**************************************************/
+static void prepare_decaps(unsigned int i, int cls)
+{
+  if(cls == 0)
+    memcpy(slots[i], ct, CRYPTO_CIPHERTEXTBYTES);
+  else
+    rand_bytes(slots[i], CRYPTO_CIPHERTEXTBYTES);
+}
+
+static void run_decaps(unsigned int i)
+{
+  crypto_kem_dec(ss, slots[i], sk);
+}
+
+static void prepare_verify(unsigned int i, int cls)
+{
+  if(cls == 0)
+    memcpy(slots[i], fixed, CRYPTO_CIPHERTEXTBYTES);
+  else
+    rand_bytes(slots[i], CRYPTO_CIPHERTEXTBYTES);
+}
+
+static void run_verify(unsigned int i)
+{
+  volatile int r = verify(fixed, slots[i], CRYPTO_CIPHERTEXTBYTES);
+  (void)r;
+}
+
+/* slot: condition byte, then the value to move */
+static void prepare_cmov(unsigned int i, int cls)
+{
+  slots[i][0] = (uint8_t)cls;
+  rand_bytes(slots[i] + 1, KYBER_SYMBYTES);
+}
+
+static void run_cmov(unsigned int i)
+{
+  cmov(out, slots[i] + 1, KYBER_SYMBYTES, slots[i][0]);
+}
+
+static void prepare_poly(unsigned int i, int cls)
+{
+  if(cls == 0)
+    polys[i] = fixed_poly;
+  else
+    rand_poly(&polys[i]);
+}
+
+static void run_poly_tomsg(unsigned int i)
+{
+  poly_tomsg(out, &polys[i]);
+}
+
+static void run_poly_compress(unsigned int i)
+{
+  poly_compress(out, &polys[i]);
+}
+
+static void prepare_cbd(unsigned int i, int cls)
+{
+  if(cls == 0)
+    memcpy(slots[i], fixed, KYBER_ETA1*KYBER_N/4);
+  else
+    rand_bytes(slots[i], KYBER_ETA1*KYBER_N/4);
+}
+
+static void run_cbd(unsigned int i)
+{
+  cbd_eta1(&out_poly, slots[i]);
+}
+
+#ifdef cbd_eta1_keccak
+static void prepare_cbd_keccak(unsigned int i, int cls)
+{
+  if(cls == 0)
+    states[i] = fixed_state;
+  else
+    rand_bytes((uint8_t *)states[i].s, sizeof(states[i].s));
+}
+
+static void run_cbd_eta1_keccak(unsigned int i)
+{
+  cbd_eta1_keccak(&out_poly, &states[i]);
+}
+
+static void run_cbd_eta2_keccak(unsigned int i)
+{
+  cbd_eta2_keccak(&out_poly, &states[i]);
+}
+#endif
+
+static const target targets[] = {
+  { "decaps",        prepare_decaps, run_decaps },
+  { "verify",        prepare_verify, run_verify },
+  { "cmov",          prepare_cmov,   run_cmov },
+  { "poly_tomsg",    prepare_poly,   run_poly_tomsg },
+  { "cbd_eta1",      prepare_cbd,    run_cbd },
+#ifdef cbd_eta1_keccak
+  { "cbd_eta1_keccak", prepare_cbd_keccak, run_cbd_eta1_keccak },
+  { "cbd_eta2_keccak", prepare_cbd_keccak, run_cbd_eta2_keccak },
+#endif
+  { "poly_compress", prepare_poly,   run_poly_compress },
+};
+#define NTARGETS (sizeof(targets)/sizeof(targets[0]))
+
+/*************************************************
+* Welch's t-test, updated online (Welford)
+**************************************************/
+static void ttest_push(ttest *t, int cls, double x)
+{
+  double delta;
+
+  t->n[cls]++;
+  delta = x - t->mean[cls];
+  t->mean[cls] += delta / t->n[cls];
+  t->m2[cls] += delta * (x - t->mean[cls]);
+}
+
+static double ttest_t(const ttest *t)
+{
+  double v0, v1;
+
+  if(t->n[0] < 2 || t->n[1] < 2)
+    return 0;
+  v0 = t->m2[0] / (t->n[0] - 1);
+  v1 = t->m2[1] / (t->n[1] - 1);
+  if(v0 + v1 == 0)
+    return t->mean[0] == t->mean[1] ? 0 : INFINITY;
+  return (t->mean[0] - t->mean[1]) / sqrt(v0/t->n[0] + v1/t->n[1]);
+}
+
+static int cmp_uint64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/*************************************************
+* Name:        measure
+*
+* Description: Run the t-tests of one target
+*
+* Arguments:   - const target *tg:         target
+*              - unsigned long long nmeas: number of measurements
+*              - double *tmax:             largest |t| of all tests
+*              - double *traw:             |t| without cropping
+*              - double *n:                measurements in the test of tmax
+**************************************************/
+static void measure(const target *tg, unsigned long long nmeas,
+                    double *tmax, double *traw, double *n)
+{
+  ttest raw, crop[NCROPS];
+  uint64_t thresholds[NCROPS], sorted[NBATCH], t0;
+  unsigned long long done;
+  unsigned int i, j;
+  double t;
+
+  memset(&raw, 0, sizeof(raw));
+  memset(crop, 0, sizeof(crop));
+
+  for(done=0;done<nmeas;done+=NBATCH) {
+    for(i=0;i<NBATCH;i++) {
+      classes[i] = (int)(rand64() & 1);
+      tg->prepare(i, classes[i]);
+    }
+    for(i=0;i<NBATCH;i++) {
+      t0 = cpucycles();
+      tg->run(i);
+      cycles[i] = cpucycles() - t0;
+    }
+
+    /* the first batch only warms up and sets the crop thresholds at
+       the percentiles 1 - 0.5^(10(j+1)/NCROPS) */
+    if(done == 0) {
+      memcpy(sorted, cycles, sizeof(sorted));
+      qsort(sorted, NBATCH, sizeof(sorted[0]), cmp_uint64);
+      for(j=0;j<NCROPS;j++)
+        thresholds[j] = sorted[(size_t)((1 - pow(0.5, 10.0*(j+1)/NCROPS))
+                                        * NBATCH)];
+      continue;
+    }
+
+    for(i=0;i<NBATCH;i++) {
+      ttest_push(&raw, classes[i], (double)cycles[i]);
+      for(j=0;j<NCROPS;j++)
+        if(cycles[i] < thresholds[j])
+          ttest_push(&crop[j], classes[i], (double)cycles[i]);
+    }
+  }
+
+  *traw = fabs(ttest_t(&raw));
+  *tmax = *traw;
+  *n = raw.n[0] + raw.n[1];
+  for(j=0;j<NCROPS;j++) {
+    t = fabs(ttest_t(&crop[j]));
+    if(t > *tmax) {
+      *tmax = t;
+      *n = crop[j].n[0] + crop[j].n[1];
+    }
+  }
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr, "usage: %s [-n measurements] [-s seed] [-t target] "
+                  "[-f text|json]\n", prog);
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long long nmeas = 100000;
+  const char *only = NULL;
+  unsigned int i;
+  int json = 0, leak = 0, found = 0;
+  double tmax, traw, n;
+
+  for(i=1;i<(unsigned int)argc;i++) {
+    if(!strcmp(argv[i], "-n") && i+1 < (unsigned int)argc) {
+      nmeas = strtoull(argv[++i], NULL, 10);
+      if(nmeas == 0) usage(argv[0]);
+    }
+    else if(!strcmp(argv[i], "-s") && i+1 < (unsigned int)argc)
+      rng_state ^= strtoull(argv[++i], NULL, 0);
+    else if(!strcmp(argv[i], "-t") && i+1 < (unsigned int)argc)
+      only = argv[++i];
+    else if(!strcmp(argv[i], "-f") && i+1 < (unsigned int)argc) {
+      i++;
+      if(!strcmp(argv[i], "json")) json = 1;
+      else if(strcmp(argv[i], "text")) usage(argv[0]);
+    }
+    else
+      usage(argv[0]);
+  }
+  /* one warm-up batch on top of the requested measurements */
+  nmeas = (nmeas + NBATCH-1)/NBATCH*NBATCH + NBATCH;
+
+  crypto_kem_keypair(pk, sk);
+  crypto_kem_enc(ct, ss, pk);
+  rand_bytes(fixed, sizeof(fixed));
+  rand_poly(&fixed_poly);
+#ifdef cbd_eta1_keccak
+  rand_bytes((uint8_t *)fixed_state.s, sizeof(fixed_state.s));
+#endif
+
+  for(i=0;i<NTARGETS;i++) {
+    if(only && strcmp(only, targets[i].name))
+      continue;
+    found = 1;
+    measure(&targets[i], nmeas, &tmax, &traw, &n);
+    leak |= tmax > T_LEAK;
+    if(json)
+      printf("{\"impl\":\"%s\",\"scheme\":\"%s\",\"target\":\"%s\","
+             "\"n\":%.0f,\"t\":%.2f,\"t_raw\":%.2f,\"leak\":%s}\n",
+             IMPL_NAME, CRYPTO_ALGNAME, targets[i].name, n, tmax, traw,
+             tmax > T_LEAK ? "true" : "false");
+    else
+      printf("%-10s %-14s %-15s %9.0f %8.2f %8.2f  %s\n",
+             IMPL_NAME, CRYPTO_ALGNAME, targets[i].name, n, tmax, traw,
+             tmax > T_LEAK ? "LEAK" : "ok");
+    fflush(stdout);
+  }
+  if(!found)
+    usage(argv[0]);
+  return leak;
+}
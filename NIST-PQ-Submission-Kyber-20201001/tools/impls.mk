@@ -0,0 +1,54 @@
+# Implementations and parameter sets covered by the tools, and their
+# sources. Included by the tool Makefiles after they define their rule
+# template:
+#   define rule   $(1) implementation, $(2) scheme, $(3) source directory,
+#                 $(4) sources, $(5) extra flags
+# which is instantiated here for every implementation and scheme;
+# BINARIES_<impl> collects the targets and BINARIES those of IMPLS.
+# IMPL_RNG is the randombytes source of the ref-style implementations;
+# set it empty before the include to provide randombytes in the tool.
+# The m4 implementation only runs on Cortex-M4 boards and is not covered.
+# The clean implementation needs PQClean's common/ directory, which is not
+# part of this tree; pass CLEAN_COMMON=<path> and add clean to IMPLS.
+
+TOP = ../..
+REF = $(TOP)/Reference_Implementation/crypto_kem/kyber768
+OPT = $(TOP)/Optimized_Implementation/crypto_kem/kyber768
+VEC = $(TOP)/Additional_Implementations/vec/crypto_kem/kyber768
+AVX2 = $(TOP)/Additional_Implementations/avx2/crypto_kem
+CLEAN = $(TOP)/Additional_Implementations/clean/crypto_kem
+CLEAN_COMMON ?=
+
+IMPLS ?= ref optimized vec avx2
+SCHEMES = kyber512 kyber768 kyber1024 kyber512-90s kyber768-90s kyber1024-90s
+IMPL_RNG ?= rng.c
+
+flags_kyber512 = -DKYBER_K=2
+flags_kyber768 = -DKYBER_K=3
+flags_kyber1024 = -DKYBER_K=4
+flags_kyber512-90s = -DKYBER_K=2 -DKYBER_90S
+flags_kyber768-90s = -DKYBER_K=3 -DKYBER_90S
+flags_kyber1024-90s = -DKYBER_K=4 -DKYBER_90S
+is90s = $(findstring 90s,$(1))
+
+REF_SOURCES = cbd.c fips202.c indcpa.c kem.c ntt.c pack.c poly.c polyvec.c reduce.c $(IMPL_RNG) verify.c \
+  $(if $(call is90s,$(1)),symmetric-aes.c aes256ctr.c sha256.c sha512.c,symmetric-shake.c)
+OPT_SOURCES = cbd.c fips202.c indcpa.c kem.c ntt.c poly.c polyvec.c reduce.c $(IMPL_RNG) verify.c \
+  $(if $(call is90s,$(1)),symmetric-aes.c aes256ctr.c sha256.c sha512.c,symmetric-shake.c)
+AVX2_SOURCES = cbd.c consts.c indcpa.c kem.c poly.c polyvec.c rejsample.c $(IMPL_RNG) verify.c \
+  fq.S invntt.S ntt.S shuffle.S basemul.S \
+  $(if $(call is90s,$(1)),aes256ctr.c,fips202.c fips202x4.c keccak4x/KeccakP-1600-times4-SIMD256.c symmetric-shake.c)
+CLEAN_SOURCES = cbd.c indcpa.c kem.c ntt.c poly.c polyvec.c reduce.c verify.c \
+  $(if $(call is90s,$(1)),aes256ctr.c,symmetric-shake.c)
+CLEAN_COMMON_SOURCES = randombytes.c $(if $(call is90s,$(1)),sha2.c,fips202.c)
+CLEAN_NAMESPACE = PQCLEAN_$(shell echo $(1) | tr a-z- A-Z_)_CLEAN_
+
+$(foreach s,$(SCHEMES),$(eval $(call rule,ref,$(s),$(REF),$(call REF_SOURCES,$(s)))))
+$(foreach s,$(SCHEMES),$(eval $(call rule,optimized,$(s),$(OPT),$(call OPT_SOURCES,$(s)))))
+$(foreach s,$(SCHEMES),$(eval $(call rule,vec,$(s),$(VEC),$(call OPT_SOURCES,$(s)))))
+$(foreach s,$(SCHEMES),$(eval $(call rule,avx2,$(s),$(AVX2)/$(s),$(call AVX2_SOURCES,$(s)))))
+$(foreach s,$(SCHEMES),$(eval $(call rule,clean,$(s),$(CLEAN)/$(s),$(call CLEAN_SOURCES,$(s)), \
+  -I$(CLEAN_COMMON) -DPQCLEAN_NAMESPACE=$(call CLEAN_NAMESPACE,$(s)) \
+  $(addprefix $(CLEAN_COMMON)/,$(call CLEAN_COMMON_SOURCES,$(s))))))
+
+BINARIES = $(foreach i,$(IMPLS),$(BINARIES_$(i)))
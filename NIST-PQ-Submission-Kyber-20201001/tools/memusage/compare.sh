@@ -0,0 +1,21 @@
+#!/bin/sh
+# usage: compare.sh old new [tolerance]
+# Compares two memusage tables and fails if the stack or peak heap use of
+# any operation grew by more than tolerance bytes, or if an operation of
+# the old table is missing from the new one.
+old=$1; new=$2; tol=${3:-0}
+awk -v tol="$tol" '
+  /^#/ { next }
+  NR == FNR { stack[$1" "$2" "$3] = $4; heap[$1" "$2" "$3] = $6; next }
+  {
+    k = $1" "$2" "$3
+    seen[k] = 1
+    if(!(k in stack)) { printf "new      %-40s stack %8d heap %8d\n", k, $4, $6; next }
+    d = $4 - stack[k]; h = $6 - heap[k]
+    if(d > tol || h > tol) { printf "GREW     %-40s stack %+8d heap %+8d\n", k, d, h; bad = 1 }
+    else if(d < 0 || h < 0) printf "shrank   %-40s stack %+8d heap %+8d\n", k, d, h
+  }
+  END {
+    for(k in stack) if(!(k in seen)) { printf "MISSING  %s\n", k; bad = 1 }
+    exit bad
+  }' "$old" "$new"
@@ -0,0 +1,331 @@
+/*
+ * Peak stack and heap use of the KEM entry points.
+ *
+ * Every operation runs in a fresh thread whose stack is a buffer painted
+ * with a fixed byte; after the thread has finished, the lowest overwritten
+ * byte gives the high-water mark. The same measurement for an empty
+ * operation (thread start-up, TLS placed on the stack by the C library) is
+ * subtracted. Heap use is recorded by wrapping malloc, calloc, realloc and
+ * free at link time (-Wl,--wrap=...), so only calls made by the
+ * implementation itself are counted, not those inside the C library or
+ * OpenSSL.
+ *
+ * randombytes is provided here as a deterministic generator, so the
+ * AES-based NIST DRBG of rng.c and its OpenSSL calls are not part of the
+ * numbers.
+ *
+ * Output: one line per operation with
+ *   implementation, scheme, operation, stack bytes, heap allocations,
+ *   peak live heap bytes, caller-provided buffer bytes
+ */
+#define _XOPEN_SOURCE 700
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef PQCLEAN_NAMESPACE
+/* PQClean layout: every API name carries the scheme prefix */
+#include "api.h"
+#define MEM_CAT_(a,b) a##b
+#define MEM_CAT(a,b) MEM_CAT_(a,b)
+#define MEM_NS(s) MEM_CAT(PQCLEAN_NAMESPACE,s)
+#define CRYPTO_PUBLICKEYBYTES MEM_NS(CRYPTO_PUBLICKEYBYTES)
+#define CRYPTO_SECRETKEYBYTES MEM_NS(CRYPTO_SECRETKEYBYTES)
+#define CRYPTO_CIPHERTEXTBYTES MEM_NS(CRYPTO_CIPHERTEXTBYTES)
+#define CRYPTO_BYTES MEM_NS(CRYPTO_BYTES)
+#define CRYPTO_ALGNAME MEM_NS(CRYPTO_ALGNAME)
+#define crypto_kem_keypair MEM_NS(crypto_kem_keypair)
+#define crypto_kem_enc MEM_NS(crypto_kem_enc)
+#define crypto_kem_dec MEM_NS(crypto_kem_dec)
+#else
+#include "api.h"
+#endif
+
+#ifndef IMPL_NAME
+#define IMPL_NAME "unknown"
+#endif
+
+#define STACKBYTES (1UL << 20)
+#define PAINT 0xA5
+#define REPEAT 4
+
+enum op {
+  OP_NONE,
+  OP_KEYPAIR,
+  OP_ENC,
+  OP_DEC,
+#ifdef CRYPTO_CTXALIGN
+  OP_KEYPAIR_CTX,
+  OP_ENC_CTX,
+  OP_DEC_CTX,
+#endif
+  OP_END
+};
+
+static const char *op_name[] = {
+  "none",
+  "keypair",
+  "enc",
+  "dec",
+#ifdef CRYPTO_CTXALIGN
+  "keypair_ctx",
+  "enc_ctx",
+  "dec_ctx",
+#endif
+};
+
+typedef struct {
+  enum op op;
+  uint8_t *pk, *sk, *ct, *ss;
+  void *ctx;
+} job;
+
+/*************************************************
+* Heap accounting
+*
+* Every block carries its size in a header of HEADERBYTES bytes, which
+* keeps the alignment of malloc for the user part.
+**************************************************/
+#define HEADERBYTES 16
+
+static int heap_tracking;
+static size_t heap_allocs, heap_live, heap_peak;
+
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t m, size_t n);
+void *__real_realloc(void *p, size_t n);
+void __real_free(void *p);
+
+void *__wrap_malloc(size_t n);
+void *__wrap_calloc(size_t m, size_t n);
+void *__wrap_realloc(void *p, size_t n);
+void __wrap_free(void *p);
+
+static void heap_add(size_t n)
+{
+  if(!heap_tracking)
+    return;
+  heap_allocs++;
+  heap_live += n;
+  if(heap_live > heap_peak)
+    heap_peak = heap_live;
+}
+
+static void heap_sub(size_t n)
+{
+  if(heap_tracking && heap_live >= n)
+    heap_live -= n;
+}
+
+void *__wrap_malloc(size_t n)
+{
+  uint8_t *p = __real_malloc(n + HEADERBYTES);
+
+  if(p == NULL)
+    return NULL;
+  memcpy(p, &n, sizeof(n));
+  heap_add(n);
+  return p + HEADERBYTES;
+}
+
+void *__wrap_calloc(size_t m, size_t n)
+{
+  uint8_t *p;
+
+  if(n != 0 && m > (SIZE_MAX - HEADERBYTES)/n)
+    return NULL;
+  p = __wrap_malloc(m*n);
+  if(p != NULL)
+    memset(p, 0, m*n);
+  return p;
+}
+
+void *__wrap_realloc(void *p, size_t n)
+{
+  uint8_t *q;
+  size_t old;
+
+  if(p == NULL)
+    return __wrap_malloc(n);
+  q = (uint8_t *)p - HEADERBYTES;
+  memcpy(&old, q, sizeof(old));
+  q = __real_realloc(q, n + HEADERBYTES);
+  if(q == NULL)
+    return NULL;
+  memcpy(q, &n, sizeof(n));
+  heap_sub(old);
+  heap_add(n);
+  return q + HEADERBYTES;
+}
+
+void __wrap_free(void *p)
+{
+  uint8_t *q;
+  size_t n;
+
+  if(p == NULL)
+    return;
+  q = (uint8_t *)p - HEADERBYTES;
+  memcpy(&n, q, sizeof(n));
+  heap_sub(n);
+  __real_free(q);
+}
+
+/*************************************************
+* Deterministic randombytes
+**************************************************/
+#ifndef PQCLEAN_NAMESPACE
+int randombytes(unsigned char *x, unsigned long long xlen);
+
+int randombytes(unsigned char *x, unsigned long long xlen)
+{
+  static uint64_t s = 0x9E3779B97F4A7C15ULL;
+
+  while(xlen--) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    *x++ = (unsigned char)s;
+  }
+  return 0;
+}
+#endif
+
+/*************************************************
+* Measurement
+**************************************************/
+static void *run(void *arg)
+{
+  job *j = arg;
+
+  heap_allocs = heap_live = heap_peak = 0;
+  heap_tracking = 1;
+  switch(j->op) {
+    case OP_KEYPAIR:
+      crypto_kem_keypair(j->pk, j->sk);
+      break;
+    case OP_ENC:
+      crypto_kem_enc(j->ct, j->ss, j->pk);
+      break;
+    case OP_DEC:
+      crypto_kem_dec(j->ss, j->ct, j->sk);
+      break;
+#ifdef CRYPTO_CTXALIGN
+    case OP_KEYPAIR_CTX:
+      crypto_kem_keypair_ctx(j->pk, j->sk, j->ctx);
+      break;
+    case OP_ENC_CTX:
+      crypto_kem_enc_ctx(j->ct, j->ss, j->pk, j->ctx);
+      break;
+    case OP_DEC_CTX:
+      crypto_kem_dec_ctx(j->ss, j->ct, j->sk, j->ctx);
+      break;
+#endif
+    default:
+      break;
+  }
+  heap_tracking = 0;
+  return NULL;
+}
+
+static size_t stack_peak(uint8_t *stack, job *j)
+{
+  size_t i;
+  pthread_t t;
+  pthread_attr_t attr;
+
+  memset(stack, PAINT, STACKBYTES);
+  if(pthread_attr_init(&attr)
+     || pthread_attr_setstack(&attr, stack, STACKBYTES)
+     || pthread_create(&t, &attr, run, j)
+     || pthread_join(t, NULL)) {
+    fprintf(stderr, "memusage: cannot run thread on painted stack\n");
+    exit(1);
+  }
+  pthread_attr_destroy(&attr);
+
+  /* the stack grows down */
+  for(i=0;i<STACKBYTES;i++)
+    if(stack[i] != PAINT)
+      break;
+  return STACKBYTES - i;
+}
+
+static size_t buffer_bytes(enum op op)
+{
+  switch(op) {
+    case OP_KEYPAIR:
+      return CRYPTO_PUBLICKEYBYTES + CRYPTO_SECRETKEYBYTES;
+    case OP_ENC:
+      return CRYPTO_CIPHERTEXTBYTES + CRYPTO_BYTES + CRYPTO_PUBLICKEYBYTES;
+    case OP_DEC:
+      return CRYPTO_BYTES + CRYPTO_CIPHERTEXTBYTES + CRYPTO_SECRETKEYBYTES;
+#ifdef CRYPTO_CTXALIGN
+    case OP_KEYPAIR_CTX:
+    case OP_ENC_CTX:
+    case OP_DEC_CTX:
+      return buffer_bytes((enum op)(op - OP_KEYPAIR_CTX + OP_KEYPAIR))
+             + crypto_kem_ctxbytes();
+#endif
+    default:
+      return 0;
+  }
+}
+
+int main(void)
+{
+  unsigned int i,r;
+  size_t base, peak, allocs, hpeak;
+  uint8_t *stack, *ctxmem = NULL;
+  job j;
+
+  stack = malloc(STACKBYTES);
+  j.pk = malloc(CRYPTO_PUBLICKEYBYTES);
+  j.sk = malloc(CRYPTO_SECRETKEYBYTES);
+  j.ct = malloc(CRYPTO_CIPHERTEXTBYTES);
+  j.ss = malloc(CRYPTO_BYTES);
+  j.ctx = NULL;
+#ifdef CRYPTO_CTXALIGN
+  /* aligned_alloc is not wrapped, so align a malloc'ed block by hand */
+  ctxmem = malloc(crypto_kem_ctxbytes() + CRYPTO_CTXALIGN);
+  if(ctxmem != NULL)
+    j.ctx = ctxmem + (CRYPTO_CTXALIGN - (uintptr_t)ctxmem % CRYPTO_CTXALIGN);
+#endif
+  if(!stack || !j.pk || !j.sk || !j.ct || !j.ss
+#ifdef CRYPTO_CTXALIGN
+     || !j.ctx
+#endif
+    ) {
+    fprintf(stderr, "memusage: out of memory\n");
+    return 1;
+  }
+
+  j.op = OP_NONE;
+  base = stack_peak(stack, &j);
+
+  for(i=OP_KEYPAIR;i<OP_END;i++) {
+    j.op = i;
+    peak = allocs = hpeak = 0;
+    /* keys and ciphertexts change between runs; keep the maximum */
+    for(r=0;r<REPEAT;r++) {
+      size_t s = stack_peak(stack, &j);
+      if(s > peak) peak = s;
+      if(heap_allocs > allocs) allocs = heap_allocs;
+      if(heap_peak > hpeak) hpeak = heap_peak;
+    }
+    printf("%-10s %-14s %-12s %8zu %6zu %8zu %8zu\n",
+           IMPL_NAME, CRYPTO_ALGNAME, op_name[i],
+           peak > base ? peak - base : 0, allocs, hpeak, buffer_bytes(i));
+  }
+
+  free(stack);
+  free(j.pk);
+  free(j.sk);
+  free(j.ct);
+  free(j.ss);
+  free(ctxmem);
+  return 0;
+}